@@ -0,0 +1,116 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Benchmark comparing per-key calls of contains, insert, and remove against contains_batch, insert_batch, and remove_batch. A list
+	of random keys is built, then batches of random keys are looked up, inserted, and removed one key at a time and as a batch, both
+	sorted and in arrival order. Results are printed as nanoseconds per key.
+
+	Usage:	batch_bench [list size] [batch size] [batches]
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../skiplist.h"
+
+using namespace std;
+
+typedef SkipList<long long> List;
+
+//returns the nanoseconds per key taken by calling run once
+template<class Function>
+double timePerKey(Function run, size_t keys) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	run();
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+	return chrono::duration<double, nano>(stop - start).count() / keys;
+}
+
+int main(int argc, char** argv) {
+	size_t listSize = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+	size_t batchSize = (argc > 2) ? strtoul(argv[2], NULL, 10) : 4096;
+	size_t batches = (argc > 3) ? strtoul(argv[3], NULL, 10) : 64;
+
+	mt19937_64 random(42);
+	uniform_int_distribution<long long> keyRange(0, (long long)listSize * 4);
+
+	vector<long long> initial(listSize);
+	for (size_t i = 0; i < listSize; i++) {
+		initial[i] = keyRange(random);
+	}
+	sort(initial.begin(), initial.end());
+	List list(initial.begin(), initial.end(), sorted_tag());
+
+	vector<vector<long long> > arrival(batches), sorted(batches);
+	for (size_t b = 0; b < batches; b++) {
+		for (size_t i = 0; i < batchSize; i++) {
+			arrival[b].push_back(keyRange(random));
+		}
+		sorted[b] = arrival[b];
+		sort(sorted[b].begin(), sorted[b].end());
+		sorted[b].erase(unique(sorted[b].begin(), sorted[b].end()), sorted[b].end());
+	}
+	size_t keys = batches * batchSize;
+	vector<bool> found;
+	int sink = 0;
+
+	printf("list size %zu, batch size %zu, batches %zu\n", listSize, batchSize, batches);
+	printf("%-34s %10s\n", "operation", "ns/key");
+
+	printf("%-34s %10.1f\n", "contains, one key at a time", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			for (size_t i = 0; i < arrival[b].size(); i++) {
+				sink += list.contains(arrival[b][i]);
+			}
+		}
+	}, keys));
+	printf("%-34s %10.1f\n", "contains_batch, arrival order", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			found.clear();
+			sink += list.contains_batch(arrival[b].begin(), arrival[b].end(), back_inserter(found));
+		}
+	}, keys));
+	printf("%-34s %10.1f\n", "contains_batch, sorted", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			found.clear();
+			sink += list.contains_batch(sorted[b].begin(), sorted[b].end(), back_inserter(found));
+		}
+	}, keys));
+
+	List perKey(list);
+	printf("%-34s %10.1f\n", "insert, one key at a time", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			for (size_t i = 0; i < sorted[b].size(); i++) {
+				sink += perKey.insert(sorted[b][i]);
+			}
+		}
+	}, keys));
+	printf("%-34s %10.1f\n", "remove, one key at a time", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			for (size_t i = 0; i < sorted[b].size(); i++) {
+				sink += perKey.remove(sorted[b][i]);
+			}
+		}
+	}, keys));
+	List batched(list);
+	printf("%-34s %10.1f\n", "insert_batch, sorted", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			sink += batched.insert_batch(sorted[b].begin(), sorted[b].end());
+		}
+	}, keys));
+	printf("%-34s %10.1f\n", "remove_batch, sorted", timePerKey([&]() {
+		for (size_t b = 0; b < batches; b++) {
+			sink += batched.remove_batch(sorted[b].begin(), sorted[b].end());
+		}
+	}, keys));
+
+	return sink == -1;
+}
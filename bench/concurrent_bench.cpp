@@ -0,0 +1,240 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Stress test and scaling benchmark for ConcurrentSkipList, LazySkipList, and ShardedSkipList.
+
+	The stress test runs two phases on each list and exits with a non-zero status if either one finds the list in a wrong state:
+		- owned keys: each thread inserts and removes random keys that only it writes, while looking up keys of every thread, and
+		  keeps its own record of which of its keys are in the list. Afterwards every key is checked against the records.
+		- shared keys: every thread inserts and removes random keys from one small range that all threads write. Afterwards the
+		  size of the list has to equal the number of successful inserts minus the number of successful removes, and has to match
+		  the number of keys contains finds.
+
+	The benchmark runs a read-mostly mix, 90% contains by default and the rest split evenly between insert and remove, on a list
+	filled to half of the key range, with 1 thread up to the maximum number of threads, doubling each time. The same mix is run on a
+	SkipList guarded by one mutex for comparison. The ShardedSkipList is rebalanced after it is filled, as a long running list would
+	be by then. Results are printed as millions of operations per second across all threads.
+
+	Usage:	concurrent_bench [max threads] [key range] [operations per thread] [contains percent]
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../concurrentskiplist.h"
+#include "../lazyskiplist.h"
+#include "../shardedskiplist.h"
+#include "../skiplist.h"
+
+using namespace std;
+
+typedef ConcurrentSkipList<long long> ConcurrentList;
+typedef LazySkipList<long long> LazyList;
+typedef ShardedSkipList<long long> ShardedList;
+typedef SkipList<long long> List;
+
+//SkipList behind one mutex, the way it has to be shared between threads
+class LockedList {
+
+	public:
+
+	bool contains(long long key) { lock_guard<mutex> hold(lock); return list.contains(key); };
+	bool insert(long long key) { lock_guard<mutex> hold(lock); return list.insert(key); };
+	bool remove(long long key) { lock_guard<mutex> hold(lock); return list.remove(key); };
+
+	private:
+
+	mutex lock;
+	List list;
+};
+
+//runs work(thread index) on threads threads at once and returns the seconds taken
+template<class Function>
+double runThreads(int threads, Function work) {
+	vector<thread> workers;
+	atomic<bool> go(false);
+	for (int t = 0; t < threads; t++) {
+		workers.push_back(thread([&, t]() {
+			while (!go.load()) {
+				this_thread::yield();
+			}
+			work(t);
+		}));
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	go.store(true);
+	for (int t = 0; t < threads; t++) {
+		workers[t].join();
+	}
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+	return chrono::duration<double>(stop - start).count();
+}
+
+//each thread writes only its own keys and checks the list against its record of them
+template<class ListType>
+bool stressOwnedKeys(int threads, long long keyRange, size_t operations) {
+	ListType list;
+	vector<vector<char> > present(threads, vector<char>(keyRange, 0));
+	atomic<int> errors(0);
+
+	runThreads(threads, [&](int t) {
+		mt19937_64 random(t + 1);
+		for (size_t i = 0; i < operations; i++) {
+			long long key = (long long)(random() % keyRange);
+			int choice = (int)(random() % 3);
+			if (choice == 2 || key % threads != t) {		//looks up any key, only checks keys this thread owns
+				bool found = list.contains(key);
+				if (key % threads == t && found != (present[t][key] != 0)) {
+					errors++;
+				}
+			} else if (choice == 0) {
+				if (list.insert(key) == (present[t][key] != 0)) {
+					errors++;
+				}
+				present[t][key] = 1;
+			} else {
+				if (list.remove(key) != (present[t][key] != 0)) {
+					errors++;
+				}
+				present[t][key] = 0;
+			}
+		}
+	});
+
+	int expected = 0;
+	for (long long key = 0; key < keyRange; key++) {
+		bool owned = present[key % threads][key] != 0;
+		expected += owned;
+		if (list.contains(key) != owned) {
+			errors++;
+		}
+	}
+	if (list.size() != expected) {
+		errors++;
+	}
+	return errors.load() == 0;
+}
+
+//every thread writes the same small range of keys
+template<class ListType>
+bool stressSharedKeys(int threads, long long keyRange, size_t operations) {
+	ListType list;
+	atomic<long long> net(0);
+
+	runThreads(threads, [&](int t) {
+		mt19937_64 random(t + 1000);
+		long long inserted = 0;
+		for (size_t i = 0; i < operations; i++) {
+			long long key = (long long)(random() % keyRange);
+			switch (random() % 3) {
+				case 0: inserted += list.insert(key); break;
+				case 1: inserted -= list.remove(key); break;
+				default: list.contains(key); break;
+			}
+		}
+		net += inserted;
+	});
+
+	int found = 0;
+	for (long long key = 0; key < keyRange; key++) {
+		found += list.contains(key);
+	}
+	return list.size() == net.load() && found == net.load();
+}
+
+//runs the read-mostly mix on list with threads threads and returns millions of operations per second
+template<class ListType>
+double readMostly(ListType& list, int threads, long long keyRange, size_t operations, int readPercent) {
+	double seconds = runThreads(threads, [&](int t) {
+		mt19937_64 random(t + 7);
+		long long sink = 0;
+		for (size_t i = 0; i < operations; i++) {
+			long long key = (long long)(random() % keyRange);
+			int choice = (int)(random() % 100);
+			if (choice < readPercent) {
+				sink += list.contains(key);
+			} else if (choice < readPercent + (100 - readPercent) / 2) {
+				sink += list.insert(key);
+			} else {
+				sink += list.remove(key);
+			}
+		}
+		if (sink == -1) {
+			printf(" ");
+		}
+	});
+	return threads * operations / seconds / 1e6;
+}
+
+//runs both stress tests on one list type and prints the result
+template<class ListType>
+bool stress(const char* name, int threads) {
+	bool owned = stressOwnedKeys<ListType>(threads, 100000, 200000);
+	bool shared = stressSharedKeys<ListType>(threads, 64, 200000);
+	printf("stress %s, %d threads: owned keys %s, shared keys %s\n", name, threads, owned ? "ok" : "FAILED", shared ? "ok" : "FAILED");
+	return owned && shared;
+}
+
+//fills a list with every other key of the range
+template<class ListType>
+void fill(ListType& list, long long keyRange) {
+	for (long long key = 0; key < keyRange; key += 2) {
+		list.insert(key);
+	}
+}
+
+int main(int argc, char** argv) {
+	int hardware = (int)thread::hardware_concurrency();
+	int maxThreads = (argc > 1) ? atoi(argv[1]) : (hardware > 0 ? hardware : 4);
+	long long keyRange = (argc > 2) ? atoll(argv[2]) : 1000000;
+	size_t operations = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1000000;
+	int readPercent = (argc > 4) ? atoi(argv[4]) : 90;
+	if (maxThreads < 1) {
+		maxThreads = 1;
+	}
+
+	int stressThreads = (maxThreads < 4) ? 4 : maxThreads;
+	bool passed = stress<ConcurrentList>("ConcurrentSkipList", stressThreads);
+	passed = stress<LazyList>("LazySkipList", stressThreads) && passed;
+	passed = stress<ShardedList>("ShardedSkipList", stressThreads) && passed;
+	if (!passed) {
+		return 1;
+	}
+
+	printf("key range %lld, %zu operations per thread, %d%% contains\n", keyRange, operations, readPercent);
+	printf("%8s %22s %22s %22s %22s\n", "threads", "ConcurrentSkipList", "LazySkipList", "ShardedSkipList", "SkipList + mutex");
+	for (int threads = 1; ; threads *= 2) {
+		if (threads > maxThreads) {
+			threads = maxThreads;
+		}
+		ConcurrentList concurrent;
+		LazyList lazy;
+		ShardedList sharded;
+		LockedList locked;
+		fill(concurrent, keyRange);
+		fill(lazy, keyRange);
+		fill(sharded, keyRange);
+		sharded.rebalance();
+		fill(locked, keyRange);
+		printf("%8d %17.2f Mop/s %17.2f Mop/s %17.2f Mop/s %17.2f Mop/s\n", threads,
+			readMostly(concurrent, threads, keyRange, operations, readPercent),
+			readMostly(lazy, threads, keyRange, operations, readPercent),
+			readMostly(sharded, threads, keyRange, operations, readPercent),
+			readMostly(locked, threads, keyRange, operations, readPercent));
+		if (threads == maxThreads) {
+			break;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,413 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Benchmark suite comparing SkipList and CompactSkipList, with and without previous links, with std::set and a sorted vector, and
+	SkipMap with std::map, on standard workloads.
+
+	Each structure is filled with n keys for every size n from 1K up to the maximum size, multiplying by ten each time, under three
+	key workloads (see workload.h):
+		- uniform:		random keys inserted in random order, looked up uniformly at random
+		- zipf:			random keys inserted in random order, looked up with a Zipfian distribution (theta 0.99)
+		- sequential:	increasing keys inserted in order, looked up in order
+
+	and the following operations are timed on it:
+		- insert:		filling the structure one key at a time. The sorted vector appends every key and sorts once
+		- lookup hit:	looking up keys in the structure
+		- lookup miss:	looking up keys that are not in the structure
+		- range scan:	reading the 100 keys that follow a key in the structure
+		- copy:			copying the whole structure, per key
+		- read-heavy:	95% lookups, the rest split between inserting and removing keys that are not in the starting set
+		- write-heavy:	50% lookups, 50% inserts and removes as above
+		- remove:		removing keys in the structure
+
+	Each row reports nanoseconds per operation, comparisons per operation, counted by the comparator all structures share, and for
+	insert, the bytes of heap memory the structure holds per key, counted by replacing the global operator new. Point inserts and
+	removes in a sorted vector move O(n) keys each, so the vector runs fewer of them on large sizes.
+
+	Usage:	suite_bench [max size] [operations] [workload]
+
+	The maximum size defaults to SKIPLIST_BENCH_MAX_SIZE, set when configuring with CMake. Sizes up to 100M take several gigabytes
+	of memory. The workload is uniform, zipf, sequential, or all.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <set>
+#include <vector>
+#include "workload.h"
+#include "../skiplist.h"
+#include "../compactskiplist.h"
+#include "../skipmap.h"
+
+#ifndef SKIPLIST_BENCH_MAX_SIZE
+#define SKIPLIST_BENCH_MAX_SIZE 1000000
+#endif
+
+using namespace std;
+
+static const size_t SCAN_LENGTH = 100;					//keys read by each range scan
+static const double LINEAR_UPDATE_BUDGET = 2e9;			//keys a sorted vector may move during one timed operation
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+	Heap accounting. Every block handed out by operator new carries its size in a header so operator delete can subtract it again.
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+static size_t liveBytes = 0;		//bytes currently allocated through operator new
+static const size_t HEADER = alignof(max_align_t);
+
+void* operator new(size_t bytes) {
+	char* block = static_cast<char*>(malloc(bytes + HEADER));
+	if (block == NULL) {
+		throw bad_alloc();
+	}
+	*reinterpret_cast<size_t*>(block) = bytes;
+	liveBytes += bytes;
+	return block + HEADER;
+}
+
+void operator delete(void* p) noexcept {
+	if (p != NULL) {
+		char* block = static_cast<char*>(p) - HEADER;
+		liveBytes -= *reinterpret_cast<size_t*>(block);
+		free(block);
+	}
+}
+
+void* operator new[](size_t bytes) { return operator new(bytes); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+	Structures under test. Each one wraps a container behind the same small interface.
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+struct ListBench {
+	static const char* name(void) { return "SkipList"; };
+	static const bool linearUpdates = false;
+
+	void build(const vector<BenchKey>& keys) { for (BenchKey key : keys) list.insert(key); };
+	bool contains(BenchKey key) const { return list.contains(key); };
+	bool insert(BenchKey key) { return list.insert(key); };
+	bool remove(BenchKey key) { return list.remove(key); };
+	BenchKey scan(BenchKey from, size_t length) const {
+		BenchKey sum = 0;
+		SkipList<BenchKey, CountingLess>::const_iterator it = list.lower_bound(from);
+		for (size_t i = 0; i < length && it != list.end(); i++, ++it) {
+			sum += *it;
+		}
+		return sum;
+	};
+
+	SkipList<BenchKey, CountingLess> list;
+};
+
+template<bool ForwardOnly>
+struct CompactBench {
+	static const char* name(void) { return ForwardOnly ? "Compact fwd" : "Compact"; };
+	static const bool linearUpdates = false;
+
+	void build(const vector<BenchKey>& keys) { for (BenchKey key : keys) list.insert(key); };
+	bool contains(BenchKey key) const { return list.contains(key); };
+	bool insert(BenchKey key) { return list.insert(key); };
+	bool remove(BenchKey key) { return list.remove(key); };
+	BenchKey scan(BenchKey from, size_t length) const {
+		BenchKey sum = 0;
+		typename CompactSkipList<BenchKey, CountingLess, ForwardOnly>::const_iterator it = list.lower_bound(from);
+		for (size_t i = 0; i < length && it != list.end(); i++, ++it) {
+			sum += *it;
+		}
+		return sum;
+	};
+
+	CompactSkipList<BenchKey, CountingLess, ForwardOnly> list;
+};
+
+struct SetBench {
+	static const char* name(void) { return "std::set"; };
+	static const bool linearUpdates = false;
+
+	void build(const vector<BenchKey>& keys) { for (BenchKey key : keys) set.insert(key); };
+	bool contains(BenchKey key) const { return set.find(key) != set.end(); };
+	bool insert(BenchKey key) { return set.insert(key).second; };
+	bool remove(BenchKey key) { return set.erase(key) != 0; };
+	BenchKey scan(BenchKey from, size_t length) const {
+		BenchKey sum = 0;
+		std::set<BenchKey, CountingLess>::const_iterator it = set.lower_bound(from);
+		for (size_t i = 0; i < length && it != set.end(); i++, ++it) {
+			sum += *it;
+		}
+		return sum;
+	};
+
+	std::set<BenchKey, CountingLess> set;
+};
+
+struct VectorBench {
+	static const char* name(void) { return "sorted vector"; };
+	static const bool linearUpdates = true;
+
+	void build(const vector<BenchKey>& keys) {
+		sorted.assign(keys.begin(), keys.end());
+		sort(sorted.begin(), sorted.end(), CountingLess());
+	};
+	bool contains(BenchKey key) const { return binary_search(sorted.begin(), sorted.end(), key, CountingLess()); };
+	bool insert(BenchKey key) {
+		vector<BenchKey>::iterator it = std::lower_bound(sorted.begin(), sorted.end(), key, CountingLess());
+		if (it != sorted.end() && !CountingLess()(key, *it)) {
+			return false;
+		}
+		sorted.insert(it, key);
+		return true;
+	};
+	bool remove(BenchKey key) {
+		vector<BenchKey>::iterator it = std::lower_bound(sorted.begin(), sorted.end(), key, CountingLess());
+		if (it == sorted.end() || CountingLess()(key, *it)) {
+			return false;
+		}
+		sorted.erase(it);
+		return true;
+	};
+	BenchKey scan(BenchKey from, size_t length) const {
+		BenchKey sum = 0;
+		vector<BenchKey>::const_iterator it = std::lower_bound(sorted.begin(), sorted.end(), from, CountingLess());
+		for (size_t i = 0; i < length && it != sorted.end(); i++, ++it) {
+			sum += *it;
+		}
+		return sum;
+	};
+
+	vector<BenchKey> sorted;
+};
+
+struct SkipMapBench {
+	static const char* name(void) { return "SkipMap"; };
+	static const bool linearUpdates = false;
+
+	void build(const vector<BenchKey>& keys) { for (BenchKey key : keys) map.try_emplace(key, key); };
+	bool contains(BenchKey key) const { return map.contains(key); };
+	bool insert(BenchKey key) { return map.try_emplace(key, key).second; };
+	bool remove(BenchKey key) { return map.erase(key); };
+	BenchKey scan(BenchKey from, size_t length) {
+		BenchKey sum = 0;
+		SkipMap<BenchKey, BenchKey, CountingLess>::iterator it = map.lower_bound(from);
+		for (size_t i = 0; i < length && it != map.end(); i++, ++it) {
+			sum += it->second;
+		}
+		return sum;
+	};
+
+	SkipMap<BenchKey, BenchKey, CountingLess> map;
+};
+
+struct MapBench {
+	static const char* name(void) { return "std::map"; };
+	static const bool linearUpdates = false;
+
+	void build(const vector<BenchKey>& keys) { for (BenchKey key : keys) map.try_emplace(key, key); };
+	bool contains(BenchKey key) const { return map.find(key) != map.end(); };
+	bool insert(BenchKey key) { return map.try_emplace(key, key).second; };
+	bool remove(BenchKey key) { return map.erase(key) != 0; };
+	BenchKey scan(BenchKey from, size_t length) const {
+		BenchKey sum = 0;
+		std::map<BenchKey, BenchKey, CountingLess>::const_iterator it = map.lower_bound(from);
+		for (size_t i = 0; i < length && it != map.end(); i++, ++it) {
+			sum += it->second;
+		}
+		return sum;
+	};
+
+	std::map<BenchKey, BenchKey, CountingLess> map;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+	Workloads and the benchmark driver.
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+enum KeyWorkload { UNIFORM, ZIPF, SEQUENTIAL };
+
+static const char* workloadName(KeyWorkload workload) {
+	switch (workload) {
+		case UNIFORM: return "uniform";
+		case ZIPF: return "zipf";
+		default: return "sequential";
+	}
+}
+
+//keys of one size and workload, and the order they are looked up in
+struct Workload {
+	vector<BenchKey> keys;		//keys in insertion order
+	vector<BenchKey> lookups;	//keys in the structure, in lookup order
+	vector<BenchKey> updates;	//keys in the structure, distinct, in random order, used by the mixes and remove
+};
+
+static Workload makeWorkload(KeyWorkload type, size_t n, size_t operations) {
+	Workload w;
+	w.keys = (type == SEQUENTIAL) ? sequentialKeys(n) : uniformKeys(n, 42 + n);
+	w.lookups.resize(operations);
+	if (type == ZIPF) {
+		vector<BenchKey> byRank(w.keys);
+		shuffle(byRank.begin(), byRank.end(), mt19937_64(7));
+		ZipfGenerator zipf(n, 0.99, 11);
+		for (size_t i = 0; i < operations; i++) {
+			w.lookups[i] = byRank[zipf.next()];
+		}
+	} else if (type == SEQUENTIAL) {
+		for (size_t i = 0; i < operations; i++) {
+			w.lookups[i] = w.keys[i % n];
+		}
+	} else {
+		mt19937_64 random(13);
+		for (size_t i = 0; i < operations; i++) {
+			w.lookups[i] = w.keys[random() % n];
+		}
+	}
+	w.updates = w.keys;
+	shuffle(w.updates.begin(), w.updates.end(), mt19937_64(17));
+	return w;
+}
+
+static double elapsedNanos(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* structure, const char* operation, double nanos, size_t operations, uint64_t comparisons,
+	double bytesPerKey = -1) {
+	if (operations == 0) {
+		return;
+	}
+	printf("%-14s %-12s %12.1f %10.1f", structure, operation, nanos / operations, (double)comparisons / operations);
+	if (bytesPerKey >= 0) {
+		printf(" %12.1f", bytesPerKey);
+	}
+	printf("\n");
+}
+
+//runs every operation on one structure and prints a row for each
+template<class Bench>
+void runStructure(const Workload& w, size_t operations, BenchKey& sink) {
+	size_t n = w.keys.size();
+	size_t updates = operations;
+	if (Bench::linearUpdates) {
+		updates = min(updates, (size_t)(LINEAR_UPDATE_BUDGET / n) + 1);
+	}
+	updates = min(updates, n);
+
+	size_t before = liveBytes;
+	Bench* bench = new Bench();
+	benchComparisons = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	bench->build(w.keys);
+	double nanos = elapsedNanos(start);
+	report(Bench::name(), "insert", nanos, n, benchComparisons, (double)(liveBytes - before) / n);
+
+	benchComparisons = 0;
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < operations; i++) {
+		sink += bench->contains(w.lookups[i]);
+	}
+	report(Bench::name(), "lookup hit", elapsedNanos(start), operations, benchComparisons);
+
+	benchComparisons = 0;
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < operations; i++) {
+		sink += bench->contains(w.lookups[i] + 1);			//keys are even, so key + 1 is never in the structure
+	}
+	report(Bench::name(), "lookup miss", elapsedNanos(start), operations, benchComparisons);
+
+	size_t scans = operations / SCAN_LENGTH + 1;
+	benchComparisons = 0;
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < scans; i++) {
+		sink += bench->scan(w.lookups[i], SCAN_LENGTH);
+	}
+	report(Bench::name(), "range scan", elapsedNanos(start), scans, benchComparisons);
+
+	benchComparisons = 0;
+	start = chrono::steady_clock::now();
+	Bench* copy = new Bench(*bench);
+	nanos = elapsedNanos(start);
+	report(Bench::name(), "copy", nanos, n, benchComparisons);
+	delete copy;
+
+	static const int readPercents[2] = { 95, 50 };
+	static const char* mixNames[2] = { "read-heavy", "write-heavy" };
+	for (int mix = 0; mix < 2; mix++) {
+		size_t mixOperations = Bench::linearUpdates ? min(operations, updates * 100 / (100 - readPercents[mix])) : operations;
+		size_t writes = 0;
+		benchComparisons = 0;
+		start = chrono::steady_clock::now();
+		for (size_t i = 0; i < mixOperations; i++) {
+			if ((int)(i % 100) < readPercents[mix]) {
+				sink += bench->contains(w.lookups[i]);
+			} else {
+				BenchKey key = w.updates[(writes / 2) % n] + 1;		//inserts a missing key, then removes it again
+				sink += (writes % 2 == 0) ? bench->insert(key) : bench->remove(key);
+				writes++;
+			}
+		}
+		if (writes % 2 == 1) {
+			bench->remove(w.updates[(writes / 2) % n] + 1);
+		}
+		report(Bench::name(), mixNames[mix], elapsedNanos(start), mixOperations, benchComparisons);
+	}
+
+	benchComparisons = 0;
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < updates; i++) {
+		sink += bench->remove(w.updates[i]);
+	}
+	report(Bench::name(), "remove", elapsedNanos(start), updates, benchComparisons);
+
+	delete bench;
+}
+
+int main(int argc, char** argv) {
+	size_t maxSize = (argc > 1) ? strtoul(argv[1], NULL, 10) : SKIPLIST_BENCH_MAX_SIZE;
+	size_t operations = (argc > 2) ? strtoul(argv[2], NULL, 10) : 1000000;
+	const char* only = (argc > 3) ? argv[3] : "all";
+	if (maxSize < 1000) {
+		maxSize = 1000;
+	}
+	if (operations < 1) {
+		operations = 1;
+	}
+
+	BenchKey sink = 0;
+	KeyWorkload workloads[3] = { UNIFORM, ZIPF, SEQUENTIAL };
+	for (size_t n = 1000; n <= maxSize; n = (n * 10 > maxSize) ? maxSize : n * 10) {
+		for (int k = 0; k < 3; k++) {
+			if (strcmp(only, "all") != 0 && strcmp(only, workloadName(workloads[k])) != 0) {
+				continue;
+			}
+			Workload w = makeWorkload(workloads[k], n, operations);
+			printf("\n%zu keys, %s, %zu operations\n", n, workloadName(workloads[k]), operations);
+			printf("%-14s %-12s %12s %10s %12s\n", "structure", "operation", "ns/op", "cmp/op", "bytes/key");
+			runStructure<ListBench>(w, operations, sink);
+			runStructure<CompactBench<false> >(w, operations, sink);
+			runStructure<CompactBench<true> >(w, operations, sink);
+			runStructure<SetBench>(w, operations, sink);
+			runStructure<VectorBench>(w, operations, sink);
+			runStructure<SkipMapBench>(w, operations, sink);
+			runStructure<MapBench>(w, operations, sink);
+		}
+		if (n == maxSize) {
+			break;
+		}
+	}
+
+	if (sink == 1) {
+		printf(" ");
+	}
+	return 0;
+}
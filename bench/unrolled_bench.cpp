@@ -0,0 +1,103 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Benchmark comparing SkipList with UnrolledSkipList on 32 and 64-bit integer keys. Random even keys are inserted in random order,
+	looked up as hits and as misses (each key plus one), and removed. Results are printed as nanoseconds per operation for both lists
+	and the speedup of the unrolled list. The in-node search the unrolled list was built with (AVX2, SSE, or scalar) is printed first.
+
+	Usage:	unrolled_bench [list size]
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+#include <vector>
+#include "../skiplist.h"
+#include "../unrolledskiplist.h"
+#include "workload.h"
+
+using namespace std;
+
+//returns the nanoseconds per operation taken by calling run once
+template<class Function>
+double timePerOperation(Function run, size_t operations) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	run();
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+	return chrono::duration<double, nano>(stop - start).count() / operations;
+}
+
+//times every operation on one list type, results in ns/op in the order insert, hit, miss, remove
+template<class List, class Key>
+vector<double> measure(const vector<Key>& keys, int& sink) {
+	vector<double> results;
+	List list;
+	results.push_back(timePerOperation([&]() {
+		for (size_t i = 0; i < keys.size(); i++) {
+			sink += list.insert(keys[i]);
+		}
+	}, keys.size()));
+	results.push_back(timePerOperation([&]() {
+		for (size_t i = 0; i < keys.size(); i++) {
+			sink += list.contains(keys[i]);
+		}
+	}, keys.size()));
+	results.push_back(timePerOperation([&]() {
+		for (size_t i = 0; i < keys.size(); i++) {
+			sink += list.contains(keys[i] + 1);
+		}
+	}, keys.size()));
+	results.push_back(timePerOperation([&]() {
+		for (size_t i = 0; i < keys.size(); i++) {
+			list.remove(keys[i]);
+		}
+	}, keys.size()));
+	return results;
+}
+
+//prints one table comparing the two lists on keys of type Key
+template<class Key>
+void compare(const char* name, const vector<Key>& keys, int& sink) {
+	static const char* operations[] = {"insert", "lookup hit", "lookup miss", "remove"};
+	vector<double> plain = measure<SkipList<Key>, Key>(keys, sink);
+	vector<double> unrolled = measure<UnrolledSkipList<Key>, Key>(keys, sink);
+	printf("\n%s keys, %zu per Node\n", name, (size_t)(64 / sizeof(Key)));
+	printf("%-14s %12s %12s %9s\n", "operation", "SkipList", "Unrolled", "speedup");
+	for (int i = 0; i < 4; i++) {
+		printf("%-14s %12.1f %12.1f %8.2fx\n", operations[i], plain[i], unrolled[i], plain[i] / unrolled[i]);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t listSize = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+#if defined(__AVX2__)
+	const char* search = "AVX2";
+#elif defined(__SSE4_2__)
+	const char* search = "SSE2 and SSE4.2";
+#elif defined(__SSE2__)
+	const char* search = "SSE2 for 32-bit keys, scalar for 64-bit keys";
+#else
+	const char* search = "scalar";
+#endif
+	printf("list size %zu, in-node search: %s\n", listSize, search);
+
+	vector<BenchKey> wide = uniformKeys(listSize, 42);
+	vector<uint32_t> narrow;
+	unordered_set<uint32_t> seen;
+	for (size_t i = 0; i < listSize; i++) {
+		uint32_t key = (uint32_t)(wide[i] >> 32) & ~(uint32_t)1;	//still even, so key + 1 is a miss
+		if (seen.insert(key).second) {
+			narrow.push_back(key);
+		}
+	}
+	int sink = 0;
+	compare<uint64_t>("64-bit", wide, sink);
+	compare<uint32_t>("32-bit", narrow, sink);
+	return sink == -1;
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Workload generators shared by the benchmarks. Every generator is seeded, so a run can be repeated exactly.
+
+		- uniformKeys:	n distinct random keys in random order. Every key is even, so adding 1 to a key gives a key that is
+						guaranteed to be missing
+		- sequentialKeys:	the keys 0, 2, 4, ... in increasing order
+		- ZipfGenerator:	picks ranks in [0, n) with a Zipfian distribution, rank 0 the most popular, using the method of Gray
+						et al. from "Quickly Generating Billion-Record Synthetic Databases". Ranks are mapped to keys through a
+						shuffled key array, so popular keys are spread over the whole list
+		- CountingLess:	std::less on keys that counts every call in a global counter, so that all structures report the
+						number of comparisons they make the same way
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef workload_h
+#define workload_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+typedef uint64_t BenchKey;
+
+//number of comparisons made by CountingLess since it was last reset
+static uint64_t benchComparisons = 0;
+
+struct CountingLess {
+	bool operator()(BenchKey a, BenchKey b) const {
+		benchComparisons++;
+		return a < b;
+	};
+};
+
+//returns n distinct even keys in random order
+inline vector<BenchKey> uniformKeys(size_t n, uint64_t seed) {
+	mt19937_64 random(seed);
+	vector<BenchKey> keys;
+	keys.reserve(n);
+	unordered_set<BenchKey> seen;
+	seen.reserve(n);
+	while (keys.size() < n) {
+		BenchKey key = random() & ~(BenchKey)1;
+		if (seen.insert(key).second) {
+			keys.push_back(key);
+		}
+	}
+	return keys;
+}
+
+//returns the keys 0, 2, 4, ... in increasing order
+inline vector<BenchKey> sequentialKeys(size_t n) {
+	vector<BenchKey> keys(n);
+	for (size_t i = 0; i < n; i++) {
+		keys[i] = 2 * i;
+	}
+	return keys;
+}
+
+//picks ranks in [0, n) with a Zipfian distribution of parameter theta
+class ZipfGenerator {
+
+	public:
+
+	ZipfGenerator(size_t n, double theta, uint64_t seed) : items(n), theta(theta), random(seed) {
+		double zetaN = 0;
+		for (size_t i = 1; i <= n; i++) {
+			zetaN += 1.0 / pow((double)i, theta);
+		}
+		double zeta2 = 1.0 + 1.0 / pow(2.0, theta);
+		alpha = 1.0 / (1.0 - theta);
+		eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetaN);
+		halfPowTheta = 1.0 + pow(0.5, theta);
+		this->zetaN = zetaN;
+	};
+
+	size_t next(void) {
+		double u = uniform(random);
+		double uz = u * zetaN;
+		if (uz < 1.0) {
+			return 0;
+		}
+		if (uz < halfPowTheta) {
+			return 1;
+		}
+		size_t rank = (size_t)(items * pow(eta * u - eta + 1.0, alpha));
+		return (rank < items) ? rank : items - 1;
+	};
+
+	private:
+
+	size_t items;			//number of ranks
+	double theta;			//skew, 0.99 matches YCSB
+	double zetaN;			//sum of 1 / i^theta for i in [1, n]
+	double alpha;
+	double eta;
+	double halfPowTheta;
+	mt19937_64 random;
+	uniform_real_distribution<double> uniform;
+};
+
+#endif // !workload_h
@@ -0,0 +1,104 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Benchmark of a write burst on SkipList and on BufferedSkipList with several buffer capacities. A list of random keys is built,
+	then a burst of new random keys is inserted one at a time. In the mixed burst every eighth write is a remove of a key from the
+	list and every fourth write is followed by a lookup of a random key, and the insert burst only inserts. The buffered lists are
+	flushed at the end of the burst and the flush is timed as part of it. Results are printed as nanoseconds per write and the
+	speedup over SkipList, and the lists are checked to hold the same Objects afterwards.
+
+	Usage:	write_burst_bench [list size] [burst size]
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../bufferedskiplist.h"
+#include "../skiplist.h"
+#include "workload.h"
+
+using namespace std;
+
+//returns the nanoseconds per write taken by calling run once
+template<class Function>
+double timePerWrite(Function run, size_t writes) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	run();
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+	return chrono::duration<double, nano>(stop - start).count() / writes;
+}
+
+//runs the burst on list, inserting burst keys, and if mixed removing preloaded keys and looking up lookup keys
+template<class List>
+void burst(List& list, const vector<BenchKey>& keys, size_t listSize, const vector<BenchKey>& lookups, bool mixed, int& sink) {
+	size_t removed = 0;
+	for (size_t i = listSize; i < keys.size(); i++) {
+		if (mixed && i % 8 == 0) {
+			list.remove(keys[removed++]);
+		} else {
+			list.insert(keys[i]);
+		}
+		if (mixed && i % 4 == 0) {
+			sink += list.contains(lookups[i % lookups.size()]);
+		}
+	}
+}
+
+//times the burst on SkipList and on every buffer capacity, returns false if the lists differ afterwards
+bool run(const vector<BenchKey>& keys, const vector<BenchKey>& preload, const vector<BenchKey>& lookups, bool mixed, int& sink) {
+	size_t listSize = preload.size();
+	size_t burstSize = keys.size() - listSize;
+	SkipList<BenchKey> plain(preload.begin(), preload.end(), sorted_tag());
+	double baseline = timePerWrite([&]() {
+		burst(plain, keys, listSize, lookups, mixed, sink);
+	}, burstSize);
+
+	printf("\n%s burst\n", mixed ? "mixed" : "insert");
+	printf("%-24s %12s %9s\n", "list", "ns/write", "speedup");
+	printf("%-24s %12.1f %8.2fx\n", "SkipList", baseline, 1.0);
+
+	static const size_t capacities[] = {64, 1024, 4096, 16384, 65536};
+	for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+		BufferedSkipList<BenchKey> buffered(capacities[c]);
+		for (size_t i = 0; i < preload.size(); i++) {
+			buffered.insert(preload[i]);
+		}
+		buffered.flush();
+		double perWrite = timePerWrite([&]() {
+			burst(buffered, keys, listSize, lookups, mixed, sink);
+			buffered.flush();
+		}, burstSize);
+		char name[32];
+		snprintf(name, sizeof(name), "Buffered, %zu entries", capacities[c]);
+		printf("%-24s %12.1f %8.2fx\n", name, perWrite, baseline / perWrite);
+		if (!equal(plain.begin(), plain.end(), buffered.getList().begin(), buffered.getList().end())) {
+			printf("the lists differ after the burst\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	size_t listSize = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+	size_t burstSize = (argc > 2) ? strtoul(argv[2], NULL, 10) : 200000;
+
+	vector<BenchKey> keys = uniformKeys(listSize + burstSize, 42);	//the first listSize keys are preloaded
+	vector<BenchKey> preload(keys.begin(), keys.begin() + listSize);
+	sort(preload.begin(), preload.end());
+	vector<BenchKey> lookups = uniformKeys(4096, 7);
+	int sink = 0;
+
+	printf("list size %zu, burst of %zu writes\n", listSize, burstSize);
+	if (!run(keys, preload, lookups, true, sink) || !run(keys, preload, lookups, false, sink)) {
+		return 1;
+	}
+	return sink == -1;
+}
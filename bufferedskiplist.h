@@ -0,0 +1,456 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing a write buffered Skip List for bursts of writes, in the style of the memtable of a log
+	structured store. Writes do not touch the SkipList (see skiplist.h) right away. Each one is appended to a log, an insert as the
+	Object and a remove as a tombstone for it, so recording a write is one push on to the end of an array instead of a descent of
+	the list and an allocation. The buffer has two parts: the log of recent writes in the order they were made, and a sorted run
+	with at most one entry per Object. The log is sorted and merged in to the run, the latest write of an Object winning, only when
+	a read finds it longer than the square root of the buffer capacity, so a burst of writes with no reads never sorts anything
+	until the flush, and a read never scans more than that many unsorted entries.
+
+	Once the buffer holds bufferCapacity entries, or when flush is called, the log is merged in to the run and the run in to the
+	list in sorted order: the tombstones are passed to SkipList::remove_batch and the inserts to SkipList::insert_batch, which both
+	resume each search from a finger left by the search before instead of from the top of the list. The larger the buffer, the
+	closer together the Objects of a flush are in the list and the fewer levels each finger search climbs, so large buffers are
+	where the batching pays off.
+
+	Reads see the buffer and the list together. contains checks the log from the newest write back, then the run, where a
+	tombstone hides an Object still in the list, then the list. for_each_in_range walks the part of the list in the range and the part of the buffer in the range in
+	lockstep, skipping Objects that have a tombstone and visiting buffered inserts in order, so a scan visits exactly the Objects
+	the list would hold after a flush, in ascending order.
+
+	insert and remove are blind writes and do not report whether the Object was in the list, since finding out would take the
+	descent the buffer is there to save. size checks every buffered entry against the list and costs O(b logn) for b entries.
+
+	NOTE:	Measured with write_burst_bench on a list of 1M random keys and a burst of 200K writes, on one core, over several runs.
+			With every eighth write a remove and every fourth followed by a lookup, the speedup over SkipList is 0.8 to 1.0x with
+			a 64 entry buffer, 1.2 to 1.4x with 4096, 1.3 to 1.9x with 16384, and 1.6 to 2.0x with 65536. With inserts only it is
+			0.8 to 1.1x, 1.7 to 1.9x, 2.0 to 2.6x, and 3.2 to 5.1x. Small buffers only add work, which is why the default is 16384.
+
+	NOTE:	The comparator must be a strict weak ordering. Two Objects are equal when neither comes before the other.
+
+	NOTE:	Not thread safe. Writes to the list from outside (through a copy of it) do not see the buffer.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef bufferedskiplist_h
+#define bufferedskiplist_h
+
+//imports libraries
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "skiplist.h"
+
+using namespace std;
+
+template<class Object, class Compare = less<Object>, class Allocator = SLPoolAllocator>
+
+class BufferedSkipList {
+
+	private:
+
+	struct BSLEntry {
+		Object data;		//Object written
+		bool erase;			//true for a tombstone left by remove
+	};
+
+	public:
+
+	typedef SkipList<Object, Compare, Allocator> List;
+
+	static const size_t DEFAULT_CAPACITY = 16384;	//entries buffered before a flush, 256 KB of 8-byte keys
+
+	explicit BufferedSkipList(size_t capacity = DEFAULT_CAPACITY, const Compare& comp = Compare());	//constructor taking the buffer capacity
+	int size(void) const;								//returns the number of Objects in the list and buffer together
+	bool isEmpty(void) const;							//returns true if there are no Objects
+	bool contains(const Object& target) const;			//returns true if the target is in the list or buffered
+	void insert(const Object& toInsert);				//buffers an insert of the Object
+	void remove(const Object& toRemove);				//buffers a tombstone for the Object
+	void flush(void);									//merges the buffer in to the list
+	void makeEmpty(void);								//removes every Object and drops the buffer
+	size_t pending(void) const;							//returns the number of buffered entries
+	size_t getBufferCapacity(void) const;				//returns the number of entries buffered before a flush
+	void setBufferCapacity(size_t capacity);			//changes the number of entries buffered before a flush
+	const List& getList(void) const;					//returns the list, without the buffered entries
+	template<class Function>
+	void for_each_in_range(const Object& low, const Object& high, Function visit) const;	//calls visit on each Object in [low, high)
+
+	private:
+
+	typename vector<BSLEntry>::const_iterator find(const Object& target) const;	//returns the first run entry not less than target
+	const BSLEntry* lookup(const Object& target) const;	//returns the latest buffered write of target, or NULL
+	void record(const Object& data, bool erase);		//appends a write to the log
+	void sortLog(void) const;							//merges the log in to the sorted run
+	bool entryLess(const BSLEntry& a, const BSLEntry& b) const { return compare(a.data, b.data); };
+
+	Compare compare;					//orders the Objects in the list and buffer
+	List list;							//Objects that have been flushed
+	mutable vector<BSLEntry> log;		//writes not yet merged in to the run, oldest first
+	mutable vector<BSLEntry> buffer;	//writes not yet flushed, sorted with at most one entry per Object
+	mutable vector<BSLEntry> scratch;	//space the log and run are merged in to
+	size_t bufferCapacity;				//entries buffered before a flush
+	size_t logLimit;					//log entries a read scans before the log is sorted
+};
+
+#endif // !bufferedskiplist_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list that buffers up to the parameter number of writes,
+	at least 1, before merging them in to the list, ordered with the parameter comparator.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+BufferedSkipList<Object, Compare, Allocator>::BufferedSkipList(size_t capacity, const Compare& comp)
+	: compare(comp), list(0.5, comp), bufferCapacity(0), logLimit(0) {
+	setBufferCapacity(capacity);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects a flush would leave in the list: the size of the list,
+	plus each buffered insert of an Object not in the list, minus each tombstone for an Object
+	in the list. Every entry is looked up in the list, O(b logn). Method cannot change any data
+	members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+int BufferedSkipList<Object, Compare, Allocator>::size(void) const {
+	sortLog();
+	int total = list.size();
+	for (size_t i = 0; i < buffer.size(); i++) {
+		bool inList = list.contains(buffer[i].data);
+		if (buffer[i].erase && inList) {
+			total--;
+		} else if (!buffer[i].erase && !inList) {
+			total++;
+		}
+	}
+	return total;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if a flush would leave no Objects in the list. Method cannot change any
+	data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+bool BufferedSkipList<Object, Compare, Allocator>::isEmpty(void) const {
+	sortLog();
+	for (size_t i = 0; i < buffer.size(); i++) {
+		if (!buffer[i].erase) {
+			return false;
+		}
+	}
+	return size() == 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the first entry of the sorted run whose Object is not less than the target,
+	or the end of the run. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+typename vector<typename BufferedSkipList<Object, Compare, Allocator>::BSLEntry>::const_iterator BufferedSkipList<Object, Compare, Allocator>::find(const Object& target) const {
+	return lower_bound(buffer.begin(), buffer.end(), target, [this](const BSLEntry& entry, const Object& key) {
+		return compare(entry.data, key);
+	});
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the latest buffered write of the target parameter, or NULL if there is none.
+	The log is sorted first if it is longer than logLimit, then scanned from the newest write
+	back, then the sorted run is searched. Method cannot change any data members other than
+	the order of the buffer.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+const typename BufferedSkipList<Object, Compare, Allocator>::BSLEntry* BufferedSkipList<Object, Compare, Allocator>::lookup(const Object& target) const {
+	if (log.size() > logLimit) {
+		sortLog();
+	}
+	for (size_t i = log.size(); i > 0; i--) {
+		const BSLEntry& entry = log[i - 1];
+		if (!compare(entry.data, target) && !compare(target, entry.data)) {
+			return &entry;
+		}
+	}
+	typename vector<BSLEntry>::const_iterator entry = find(target);
+	if (entry != buffer.end() && !compare(target, entry->data)) {
+		return &*entry;
+	}
+	return NULL;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target parameter is in the list once the buffer is flushed. A
+	buffered write of the target decides the answer on its own, an insert meaning it is in the
+	list and a tombstone that it is not, otherwise the list is searched. Method cannot change any
+	data members other than the order of the buffer.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+bool BufferedSkipList<Object, Compare, Allocator>::contains(const Object& target) const {
+	const BSLEntry* entry = lookup(target);
+	if (entry != NULL) {
+		return !entry->erase;
+	}
+	return list.contains(target);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method buffers an insert of the parameter Object, which replaces any earlier buffered write of
+	an equal Object, and flushes the buffer if it is full.
+
+	POSTCONDITIONS:
+		- contains returns true for the Object
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::insert(const Object& toInsert) {
+	record(toInsert, false);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method buffers a tombstone for the parameter Object, which replaces any earlier buffered
+	write of an equal Object, and flushes the buffer if it is full.
+
+	POSTCONDITIONS:
+		- contains returns false for the Object
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::remove(const Object& toRemove) {
+	record(toRemove, true);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method appends a write to the end of the log in O(1). Earlier writes of an equal Object stay
+	in the buffer until the log is sorted, where the latest one wins. Flushes the buffer once
+	the log and sorted run hold bufferCapacity entries.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::record(const Object& data, bool erase) {
+	BSLEntry written = { data, erase };
+	log.push_back(written);
+	if (log.size() + buffer.size() >= bufferCapacity) {
+		flush();
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method sorts the log with a stable sort, so equal Objects stay in the order they were
+	written, and merges it with the sorted run in one pass. Of every group of equal Objects only
+	the last write in the log is kept, and it replaces the entry of the run for that Object if
+	there is one. Runs in O(l logl + b) for l log entries. Method cannot change any data members
+	other than the order of the buffer.
+
+	POSTCONDITIONS:
+		- the log is empty
+		- the run holds the latest write of every buffered Object in sorted order
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::sortLog(void) const {
+	if (log.empty()) {
+		return;
+	}
+	stable_sort(log.begin(), log.end(), [this](const BSLEntry& a, const BSLEntry& b) {
+		return entryLess(a, b);
+	});
+	scratch.clear();
+	scratch.reserve(buffer.size() + log.size());
+	size_t run = 0;
+	for (size_t first = 0; first < log.size(); ) {
+		size_t latest = first;		//last write of the group of Objects equal to log[first]
+		while (latest + 1 < log.size() && !entryLess(log[first], log[latest + 1])) {
+			latest++;
+		}
+		while (run < buffer.size() && entryLess(buffer[run], log[latest])) {
+			scratch.push_back(std::move(buffer[run++]));
+		}
+		if (run < buffer.size() && !entryLess(log[latest], buffer[run])) {		//the write replaces the run's entry
+			run++;
+		}
+		scratch.push_back(std::move(log[latest]));
+		first = latest + 1;
+	}
+	while (run < buffer.size()) {
+		scratch.push_back(std::move(buffer[run++]));
+	}
+	buffer.swap(scratch);
+	scratch.clear();
+	log.clear();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method merges every buffered write in to the list. The log is sorted in to the run first,
+	then the tombstones are removed with one call to SkipList::remove_batch and the inserts
+	added with one call to SkipList::insert_batch, each a single left to right sweep of the list
+	using a finger since the run is sorted.
+
+	POSTCONDITIONS:
+		- the list holds every Object that contains returned true for
+		- the buffer is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::flush(void) {
+	sortLog();
+	vector<Object> inserts;
+	vector<Object> erases;
+	inserts.reserve(buffer.size());
+	for (size_t i = 0; i < buffer.size(); i++) {
+		if (buffer[i].erase) {
+			erases.push_back(std::move(buffer[i].data));
+		} else {
+			inserts.push_back(std::move(buffer[i].data));
+		}
+	}
+	buffer.clear();
+	list.remove_batch(erases.begin(), erases.end());
+	list.insert_batch(inserts.begin(), inserts.end());
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object from the list and drops every buffered write.
+
+	POSTCONDITIONS:
+		- the list and buffer are empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::makeEmpty(void) {
+	log.clear();
+	buffer.clear();
+	list.makeEmpty();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of entries waiting in the buffer. Writes of the same Object count
+	once each until the log is sorted. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+size_t BufferedSkipList<Object, Compare, Allocator>::pending(void) const {
+	return log.size() + buffer.size();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of writes buffered before the buffer is flushed. Method cannot
+	change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+size_t BufferedSkipList<Object, Compare, Allocator>::getBufferCapacity(void) const {
+	return bufferCapacity;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method changes the number of writes buffered before the buffer is flushed, at least 1, and
+	flushes right away if the buffer already holds that many. Reads sort the log once it is
+	longer than the square root of the capacity, at least 16.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+void BufferedSkipList<Object, Compare, Allocator>::setBufferCapacity(size_t capacity) {
+	bufferCapacity = (capacity > 0) ? capacity : 1;
+	logLimit = 16;
+	while (logLimit * logLimit < bufferCapacity) {
+		logLimit *= 2;
+	}
+	log.reserve(bufferCapacity);
+	buffer.reserve(bufferCapacity);
+	if (pending() >= bufferCapacity) {
+		flush();
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the list the buffer is flushed in to. It does not reflect writes that are
+	still buffered, call flush first to see every write.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+const typename BufferedSkipList<Object, Compare, Allocator>::List& BufferedSkipList<Object, Compare, Allocator>::getList(void) const {
+	return list;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method calls visit on every Object in the half-open range [low, high) that contains would
+	return true for, in ascending order. The log is sorted in to the run first, then the list is
+	walked from lower_bound(low) and the run from its first entry not less than low, in
+	lockstep: the smaller of the two is visited next, an Object of the list with a tombstone is
+	skipped, and an Object in both is visited once. Method cannot change any data members
+	other than the order of the buffer.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator>
+template<class Function>
+void BufferedSkipList<Object, Compare, Allocator>::for_each_in_range(const Object& low, const Object& high, Function visit) const {
+	sortLog();
+	typename List::const_iterator listed = list.lower_bound(low);
+	typename vector<BSLEntry>::const_iterator entry = find(low);
+	while (true) {
+		bool listDone = (listed == list.end() || !compare(*listed, high));
+		bool bufferDone = (entry == buffer.end() || !compare(entry->data, high));
+		if (listDone && bufferDone) {
+			return;
+		}
+		if (bufferDone || (!listDone && compare(*listed, entry->data))) {	//only in the list
+			visit(*listed);
+			++listed;
+		} else {
+			if (!listDone && !compare(entry->data, *listed)) {	//the entry replaces the Object in the list
+				++listed;
+			}
+			if (!entry->erase) {
+				visit(entry->data);
+			}
+			++entry;
+		}
+	}
+};
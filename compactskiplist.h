@@ -0,0 +1,660 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing a compact Skip List for large sets of small Objects such as integers. It is searched the
+	same way as SkipList (see skiplist.h), but the Nodes are not allocated one at a time. Every Node is a record in one contiguous pool
+	of cells, 4 bytes each for Objects aligned to 4 bytes or less and 8 bytes otherwise, and the links between Nodes are 32-bit cell
+	indices instead of 64-bit pointers. A record holds the Object, a link to the previous Node on the master level, and one link per
+	level. The level of a Node is not stored: remove finds it while unlinking the Node, as the number of levels on which the Node
+	before the Object links to it.
+
+		SkipList Node:		[previous 8][level 4 + 4 padding][Object][next 8 x (level + 1)]
+		CompactSkipList:	[Object][previous 4][next 4 x (level + 1)], rounded up to a whole cell
+
+	With the ForwardOnly template parameter set, records have no previous link and iterators only move forward. With 8-byte Objects
+	and a promotion probability of 0.5 a record takes about 21 bytes on average, or 18.5 bytes without the previous link, and with
+	4-byte Objects 16 or 12 bytes. A SkipList Node of an 8-byte Object takes 40 bytes plus the overhead of its allocator.
+
+	The dummy head is the record at index 0 and the end of every level is the index 0xFFFFFFFF, so no Node needs a flag or a NULL
+	check to tell the two apart. Removed records are kept on a free list for their level and reused by the next Node of that level.
+	The pool grows by a quarter of its size when it is full, which keeps the unused tail of the pool small. Since the links are
+	indices and not addresses, growing copies the pool with one memcpy and a copy of the list is one memcpy of the pool.
+
+	NOTE:	Objects must be trivially copyable with an alignment of at most 8 bytes, since records are moved with memcpy when the
+			pool grows.
+
+	NOTE:	The pool holds at most 2^32 - 1 cells, about 1.5 billion 8-byte Objects or 1 billion 4-byte Objects. Inserting past
+			that throws length_error.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef compactskiplist_h
+#define compactskiplist_h
+
+//imports libraries
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "slrandom.h"
+
+using namespace std;
+
+template<class Object, class Compare = less<Object>, bool ForwardOnly = false>
+
+class CompactSkipList {
+
+	static_assert(is_trivially_copyable<Object>::value, "CompactSkipList moves Objects with memcpy");
+	static_assert(alignof(Object) <= 8, "records are aligned to 8-byte cells");
+
+	private:
+
+	typedef uint32_t CPLIndex;		//index of the first cell of a record
+	typedef typename conditional<alignof(Object) <= 4, uint32_t, uint64_t>::type CPLCell;	//unit the pool is made of
+
+	static const CPLIndex HEAD = 0;				//index of the dummy head
+	static const CPLIndex NIL = 0xFFFFFFFFU;	//index past the end of every level
+	static const int MAX_LEVEL = 32;			//hard ceiling on the number of levels
+
+	//byte offsets of the fields of a record
+	static const size_t PREVIOUS_OFFSET = (sizeof(Object) + 3) / 4 * 4;
+	static const size_t NEXT_OFFSET = PREVIOUS_OFFSET + (ForwardOnly ? 0 : 4);
+
+	public:
+
+	//iterator over the master level, bidirectional unless the list is ForwardOnly. Objects in the
+	//list can not be changed through an iterator since that could break the order of the list
+	class const_iterator {
+
+		public:
+
+		typedef typename conditional<ForwardOnly, forward_iterator_tag, bidirectional_iterator_tag>::type iterator_category;
+		typedef Object value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const Object* pointer;
+		typedef const Object& reference;
+
+		const_iterator(void) : list(NULL), node(NIL) {};
+		reference operator*(void) const { return list->dataOf(node); };
+		pointer operator->(void) const { return &list->dataOf(node); };
+		const_iterator& operator++(void) { node = list->nextOf(node)[0]; return *this; };
+		const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; };
+		const_iterator& operator--(void) {
+			static_assert(!ForwardOnly, "a ForwardOnly list has no previous links");
+			node = (node == NIL) ? list->lastNode() : list->previousOf(node);
+			return *this;
+		};
+		const_iterator operator--(int) { const_iterator old = *this; --*this; return old; };
+		bool operator==(const const_iterator& other) const { return node == other.node; };
+		bool operator!=(const const_iterator& other) const { return node != other.node; };
+
+		private:
+
+		friend class CompactSkipList;
+		const_iterator(const CompactSkipList* l, CPLIndex n) : list(l), node(n) {};
+
+		const CompactSkipList* list;	//list being iterated, its pool may move so records are found through it
+		CPLIndex node;					//record the iterator is on, NIL past the last Node
+	};
+
+	typedef const_iterator iterator;
+
+	CompactSkipList(void);								//Default no-args constructor
+	explicit CompactSkipList(double promotion, const Compare& comp = Compare());	//constructor taking the promotion probability
+	CompactSkipList(const CompactSkipList& toCopy);		//Copy constructor
+	CompactSkipList(CompactSkipList&& toMove);			//Move constructor, takes over the pool of toMove
+	~CompactSkipList(void);								//Destructor
+	void operator=(const CompactSkipList& toCopy);		//overloaded assignment operator
+	int size(void) const;								//returns the number of Objects in the list
+	bool isEmpty(void) const;							//returns true if there are no Objects in the list
+	bool contains(const Object& target) const;			//returns true if the target is in the list
+	bool insert(const Object& toInsert);				//inserts the Object, false if it is already in the list
+	bool remove(const Object& toRemove);				//removes the Object, false if it is not in the list
+	void makeEmpty(void);								//removes every Object, the pool is kept
+	void reserve(size_t objects);						//grows the pool to hold about this many Objects
+	size_t bytes(void) const;							//returns the number of bytes held by the pool
+	void show(void) const;								//displays the list
+	const_iterator begin(void) const;					//returns an iterator to the smallest Object
+	const_iterator end(void) const;						//returns an iterator past the largest Object
+	const_iterator lower_bound(const Object& target) const;	//returns an iterator to the first Object not less than target
+
+	private:
+
+	Object& dataOf(CPLIndex node) const;				//returns the Object of a record
+	CPLIndex& previousOf(CPLIndex node) const;			//returns the previous link of a record
+	CPLIndex* nextOf(CPLIndex node) const;				//returns the next links of a record
+	static CPLIndex cellsFor(int l);					//returns the number of cells in a record on level l
+	CPLIndex findPredecessors(const Object& target, CPLIndex* update) const;	//records the Node before target on each level
+	CPLIndex lastNode(void) const;						//returns the last Node on the master level
+	CPLIndex allocate(int l);							//returns a free record on level l
+	void grow(size_t needed);							//moves the pool to a larger block
+	int randomLevel(void);								//picks the highest level for a new Node
+	void initialize(void);								//sets up an empty pool holding the dummy head
+	void trimLevels(void);								//removes empty levels from the top of the list
+
+	Compare compare;					//orders the Objects in the list
+	SLXorShift random;					//picks the height of new Nodes
+	double probability;					//chance of a Node being promoted to the next level
+	int levels;							//number of levels currently in the list
+	int count;							//number of Objects in the list
+	CPLCell* pool;						//records of every Node, the dummy head first
+	CPLIndex used;						//cells handed out from the pool
+	CPLIndex capacity;					//cells in the pool
+	CPLIndex freeLists[MAX_LEVEL];		//first removed record on each level, chained through next[0]
+};
+
+#endif // !compactskiplist_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list whose Nodes are promoted with a probability of 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+CompactSkipList<Object, Compare, ForwardOnly>::CompactSkipList(void) : probability(0.5), pool(NULL), capacity(0) {
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list whose Nodes are promoted to the next level with the
+	parameter probability, 0.5 if it is outside of (0, 1), and ordered with the parameter
+	comparator.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+CompactSkipList<Object, Compare, ForwardOnly>::CompactSkipList(double promotion, const Compare& comp)
+	: compare(comp), probability((promotion > 0.0 && promotion < 1.0) ? promotion : 0.5), pool(NULL), capacity(0) {
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Copy-constructor. Copies the pool of the parameter list with one memcpy, so the copy has the
+	same shape and free records as the parameter list. Runs in O(n).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+CompactSkipList<Object, Compare, ForwardOnly>::CompactSkipList(const CompactSkipList& toCopy)
+	: compare(toCopy.compare), random(toCopy.random), probability(toCopy.probability), pool(NULL), capacity(0) {
+	initialize();
+	*this = toCopy;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Move constructor. Takes over the pool of the parameter list in O(1). The parameter list is
+	left empty with a new pool.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+CompactSkipList<Object, Compare, ForwardOnly>::CompactSkipList(CompactSkipList&& toMove)
+	: compare(toMove.compare), random(toMove.random), probability(toMove.probability), levels(toMove.levels), count(toMove.count),
+	pool(toMove.pool), used(toMove.used), capacity(toMove.capacity) {
+	memcpy(freeLists, toMove.freeLists, sizeof(freeLists));
+	toMove.pool = NULL;
+	toMove.capacity = 0;
+	toMove.initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. Deallocates the pool. The Objects are trivially destructible, so no Node is
+	visited.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+CompactSkipList<Object, Compare, ForwardOnly>::~CompactSkipList(void) {
+	::operator delete(pool);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded assignment operator. Replaces the pool of the list with a copy of the cells in use
+	in the parameter list, in O(n) with one memcpy, and takes its level count and free records.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::operator=(const CompactSkipList& toCopy) {
+	if (this == &toCopy) {
+		return;
+	}
+	compare = toCopy.compare;
+	probability = toCopy.probability;
+	used = 0;
+	if (capacity < toCopy.used) {
+		grow(toCopy.used);
+	}
+	memcpy(pool, toCopy.pool, (size_t)toCopy.used * sizeof(CPLCell));
+	used = toCopy.used;
+	levels = toCopy.levels;
+	count = toCopy.count;
+	memcpy(freeLists, toCopy.freeLists, sizeof(freeLists));
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the list. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+int CompactSkipList<Object, Compare, ForwardOnly>::size(void) const {
+	return count;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if there are no Objects in the list. Method cannot change any data
+	members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+bool CompactSkipList<Object, Compare, ForwardOnly>::isEmpty(void) const {
+	return count == 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Methods return the fields of the record starting at the parameter index. The Object is at
+	the start of the record, followed by the previous link unless the list is ForwardOnly, and
+	one next link per level. The returned references are only valid until the pool grows.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+Object& CompactSkipList<Object, Compare, ForwardOnly>::dataOf(CPLIndex node) const {
+	return *reinterpret_cast<Object*>(pool + node);
+};
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::CPLIndex& CompactSkipList<Object, Compare, ForwardOnly>::previousOf(CPLIndex node) const {
+	static_assert(!ForwardOnly, "a ForwardOnly list has no previous links");
+	return *reinterpret_cast<CPLIndex*>(reinterpret_cast<char*>(pool + node) + PREVIOUS_OFFSET);
+};
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::CPLIndex* CompactSkipList<Object, Compare, ForwardOnly>::nextOf(CPLIndex node) const {
+	return reinterpret_cast<CPLIndex*>(reinterpret_cast<char*>(pool + node) + NEXT_OFFSET);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of cells taken by a record on level l, the fixed part of the record
+	plus one link per level, rounded up to a whole cell.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::CPLIndex CompactSkipList<Object, Compare, ForwardOnly>::cellsFor(int l) {
+	return (CPLIndex)((NEXT_OFFSET + sizeof(CPLIndex) * (l + 1) + sizeof(CPLCell) - 1) / sizeof(CPLCell));
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method searches the list from the top level of the dummy head and records the last Node
+	before the target on each level in update, if update is not NULL. Returns the Node after the
+	one recorded on the master level, the only Node that can hold the target, or NIL. Method
+	cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::CPLIndex CompactSkipList<Object, Compare, ForwardOnly>::findPredecessors(const Object& target,
+	CPLIndex* update) const {
+	CPLIndex current = HEAD;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		CPLIndex nextNode = nextOf(current)[currentLevel];
+		while (nextNode != NIL && compare(dataOf(nextNode), target)) {	//moves right while the next Node comes before target
+			current = nextNode;
+			nextNode = nextOf(current)[currentLevel];
+		}
+		if (update != NULL) {
+			update[currentLevel] = current;
+		}
+	}
+	return nextOf(current)[0];
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target parameter is in the list. Calls findPredecessors as a
+	helper function and checks that the target does not come before the Node it stopped at.
+	Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+bool CompactSkipList<Object, Compare, ForwardOnly>::contains(const Object& target) const {
+	CPLIndex candidate = findPredecessors(target, NULL);
+	return candidate != NIL && !compare(target, dataOf(candidate));
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method inserts the parameter Object in to a new record, unless it is already in the list.
+	The list is searched once by findPredecessors, which records the last Node before the Object
+	on every level as an index, so the records can move if the pool grows while the new record
+	is allocated. The new record is then sewn in after the recorded Node on each level it is on.
+
+	POSTCONDITIONS:
+		- the Object is in the list
+		- returns false if it already was
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+bool CompactSkipList<Object, Compare, ForwardOnly>::insert(const Object& toInsert) {
+	CPLIndex update[MAX_LEVEL];
+	CPLIndex nodeAfter = findPredecessors(toInsert, update);
+	if (nodeAfter != NIL && !compare(toInsert, dataOf(nodeAfter))) {
+		return false;
+	}
+
+	int nodeLevel = randomLevel();
+	if (nodeLevel == levels) {		//a Node may only grow the list by one level at a time
+		update[levels] = HEAD;
+		levels++;
+	}
+	CPLIndex node = allocate(nodeLevel);
+	new (&dataOf(node)) Object(toInsert);
+	for (int currentLevel = 0; currentLevel <= nodeLevel; currentLevel++) {
+		nextOf(node)[currentLevel] = nextOf(update[currentLevel])[currentLevel];
+		nextOf(update[currentLevel])[currentLevel] = node;
+	}
+	if constexpr (!ForwardOnly) {
+		previousOf(node) = update[0];		//HEAD if the Node is first
+		if (nextOf(node)[0] != NIL) {
+			previousOf(nextOf(node)[0]) = node;
+		}
+	}
+	count++;
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the parameter Object from the list. Its record is unlinked from every level on
+	which the Node recorded before it links to it, which gives the level of the Node, and put on
+	the free list for that level.
+
+	POSTCONDITIONS:
+		- the Object is not in the list
+		- returns false if it was not in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+bool CompactSkipList<Object, Compare, ForwardOnly>::remove(const Object& toRemove) {
+	CPLIndex update[MAX_LEVEL];
+	CPLIndex node = findPredecessors(toRemove, update);
+	if (node == NIL || compare(toRemove, dataOf(node))) {
+		return false;
+	}
+
+	int nodeLevel = 0;
+	for (int currentLevel = 0; currentLevel < levels && nextOf(update[currentLevel])[currentLevel] == node; currentLevel++) {
+		nextOf(update[currentLevel])[currentLevel] = nextOf(node)[currentLevel];
+		nodeLevel = currentLevel;
+	}
+	if constexpr (!ForwardOnly) {
+		if (nextOf(node)[0] != NIL) {
+			previousOf(nextOf(node)[0]) = update[0];
+		}
+	}
+	nextOf(node)[0] = freeLists[nodeLevel];
+	freeLists[nodeLevel] = node;
+	count--;
+	trimLevels();
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object from the list in O(1). The pool keeps its size, and is handed
+	out again from the start by the next inserts.
+
+	POSTCONDITIONS:
+		- the list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::makeEmpty(void) {
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method grows the pool so that about the parameter number of Objects fit without it growing
+	again, using the expected size of a record for the promotion probability of the list.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::reserve(size_t objects) {
+	double cellsPerObject = 0.0;
+	double share = 1.0 - probability;		//chance of a Node being on exactly level l
+	for (int l = 0; l < MAX_LEVEL; l++) {
+		cellsPerObject += share * cellsFor(l);
+		share *= probability;
+	}
+	size_t needed = (size_t)used + (size_t)(cellsPerObject * (objects > (size_t)count ? objects - count : 0)) + 1;
+	if (needed > capacity) {
+		grow(needed);
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of bytes held by the pool, including cells not handed out yet.
+	Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+size_t CompactSkipList<Object, Compare, ForwardOnly>::bytes(void) const {
+	return (size_t)capacity * sizeof(CPLCell);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a record on level l, taken from the free list for the level if it has one and
+	from the end of the pool otherwise. May grow the pool, which moves every record.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::CPLIndex CompactSkipList<Object, Compare, ForwardOnly>::allocate(int l) {
+	CPLIndex node = freeLists[l];
+	if (node != NIL) {
+		freeLists[l] = nextOf(node)[0];
+		return node;
+	}
+	size_t needed = (size_t)used + cellsFor(l);
+	if (needed > capacity) {
+		grow(needed);
+	}
+	node = used;
+	used = (CPLIndex)needed;
+	return node;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves the pool to a block of at least the parameter number of cells, and a quarter
+	more than it had if that is more, copying the cells in use with one memcpy. Throws
+	length_error if the pool would need more cells than a 32-bit index can address.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::grow(size_t needed) {
+	const size_t limit = NIL;		//the last index is the end of every level
+	if (needed > limit) {
+		throw length_error("CompactSkipList: pool is full");
+	}
+	size_t larger = (size_t)capacity + capacity / 4;
+	size_t cells = (larger > needed) ? larger : needed;
+	cells = (cells < 64) ? 64 : (cells > limit) ? limit : cells;
+	CPLCell* moved = static_cast<CPLCell*>(::operator new(cells * sizeof(CPLCell)));
+	if (pool != NULL) {
+		memcpy(moved, pool, (size_t)used * sizeof(CPLCell));
+		::operator delete(pool);
+	}
+	pool = moved;
+	capacity = (CPLIndex)cells;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the highest level a new Node will be on, taken from one word of the generator
+	(see slrandom.h). The Node is never put more than one level above the current top level or
+	past MAX_LEVEL.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+int CompactSkipList<Object, Compare, ForwardOnly>::randomLevel(void) {
+	int nodeLevel = slLevelFromWord(random(), probability);
+	if (nodeLevel > levels) {
+		nodeLevel = levels;
+	}
+	if (nodeLevel > MAX_LEVEL - 1) {
+		nodeLevel = MAX_LEVEL - 1;
+	}
+	return nodeLevel;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method empties the list: the dummy head is put at index 0 of the pool, allocating the pool if
+	there is none, with every level pointing at the end, and every free list is emptied.
+
+	POSTCONDITIONS:
+		- the list is empty and only the dummy head is in use
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::initialize(void) {
+	used = 0;
+	if (capacity < cellsFor(MAX_LEVEL - 1)) {
+		grow(cellsFor(MAX_LEVEL - 1));
+	}
+	used = cellsFor(MAX_LEVEL - 1);
+	if constexpr (!ForwardOnly) {
+		previousOf(HEAD) = NIL;
+	}
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		nextOf(HEAD)[currentLevel] = NIL;
+		freeLists[currentLevel] = NIL;
+	}
+	levels = 1;
+	count = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes empty levels from the top of the list so that searches do not start above
+	the tallest Node. The master level is never removed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::trimLevels(void) {
+	while (levels > 1 && nextOf(HEAD)[levels - 1] == NIL) {
+		levels--;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the last Node on the master level, or NIL if the list is empty, by walking
+	down from the top level. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::CPLIndex CompactSkipList<Object, Compare, ForwardOnly>::lastNode(void) const {
+	CPLIndex current = HEAD;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		while (nextOf(current)[currentLevel] != NIL) {
+			current = nextOf(current)[currentLevel];
+		}
+	}
+	return (current == HEAD) ? NIL : current;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method prints the list to the console, one level per row from the top level down, since the
+	records do not store their level. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+void CompactSkipList<Object, Compare, ForwardOnly>::show(void) const {
+	cout << "contents:" << endl;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		cout << "level " << currentLevel << ":";
+		for (CPLIndex node = nextOf(HEAD)[currentLevel]; node != NIL; node = nextOf(node)[currentLevel]) {
+			cout << "\t" << dataOf(node);
+		}
+		cout << endl;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the smallest Object in the list, or end() if the list is empty.
+	Iterators hold an index, so they stay valid when the pool grows, but not once their Node is
+	removed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::const_iterator CompactSkipList<Object, Compare, ForwardOnly>::begin(void) const {
+	return const_iterator(this, nextOf(HEAD)[0]);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator past the largest Object in the list.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::const_iterator CompactSkipList<Object, Compare, ForwardOnly>::end(void) const {
+	return const_iterator(this, NIL);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first Object that the target does not come after, or end()
+	if there is none, in O(logn). Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, bool ForwardOnly>
+typename CompactSkipList<Object, Compare, ForwardOnly>::const_iterator CompactSkipList<Object, Compare, ForwardOnly>::lower_bound(const Object& target) const {
+	return const_iterator(this, findPredecessors(target, NULL));
+};
@@ -0,0 +1,522 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing a lock-free Skip List that any number of threads can insert in to, remove from, and search
+	at the same time. It has the same insert, remove, and contains contract as SkipList: insert returns false if the Object is already in
+	the list, remove returns false if it is not, and every Object is stored once in a tower Node whose height is picked the same way.
+
+	Every next pointer is an atomic word. The lowest bit of a Node's next pointer on a level is the deletion mark of the Node on that
+	level, so a Node can not be marked and have a new Node sewn in after it by the same compare and swap. A Node is removed logically
+	by marking its next pointers from the top level down, and the thread that marks the master level owns the removal. Marked Nodes are
+	removed physically by any thread whose search walks over them. A Node is inserted by linking it on the master level first, which
+	makes it part of the list, and then on each level above. Searches that find a marked Node stop to snip it out and restart from the
+	dummy head if the Node before it changed, so every operation is lock-free. contains never writes to the list.
+
+	Unlinked Nodes are handed to an SLEpochReclaimer (see slepoch.h) so they are only deallocated once no thread can still be reading
+	them. A Node is retired by the last of the thread that inserted it and the thread that removed it to finish with it, since the
+	inserting thread may still be sewing the Node in to its upper levels when it is removed.
+
+	NOTE:	Objects are responsible for having overloaded equality and greater than operators for comparison.
+
+	NOTE:	size returns the number of Objects in the list once every operation that was running has finished. While operations
+			are running it may be briefly off by the number of running inserts and removes.
+
+	NOTE:	The number of levels only grows. Nodes are allocated with the global operator new, since the allocators in
+			slallocator.h are not thread safe.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef concurrentskiplist_h
+#define concurrentskiplist_h
+
+//imports libraries
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include "slepoch.h"
+#include "slrandom.h"
+
+using namespace std;
+
+template<class Object>
+
+class ConcurrentSkipList {
+
+	private:
+
+	struct CSLNode {
+
+		Object data;				//Object data member, stored inline
+		int level;					//highest level that the Node is on
+		atomic<int> owners;			//threads that have to finish with the Node before it is retired
+		atomic<uintptr_t> next[1];	//marked pointers to the Node after the Node, one per level.
+									//Allocated with level + 1 entries
+	};
+
+	public:
+
+	ConcurrentSkipList(void);							//Default no-args contructor
+	explicit ConcurrentSkipList(double promotion);		//constructor taking the promotion probability
+	~ConcurrentSkipList(void);							//Destructor, no other thread may use the list
+	int size(void) const;								//returns size of the list
+	bool isEmpty(void) const;							//returns bool indicating if there are any Nodes in the list
+	bool contains(const Object& target) const;			//returns true if the target object is in the list
+	bool insert(const Object& toInsert);				//inserts a new Node with the parameter Object
+	bool remove(const Object& toRemove);				//removes Node with data equal to the parameter Object
+	void show(void) const;								//displays the list, no other thread may change the list
+
+	private:
+
+	ConcurrentSkipList(const ConcurrentSkipList&);				//not copyable
+	ConcurrentSkipList& operator=(const ConcurrentSkipList&);	//not copyable
+	bool find(const Object& target, CSLNode** preds, CSLNode** succs);	//records the Nodes around target, snipping marked Nodes
+	void release(CSLNode* node);						//drops one owner of a Node, retiring it after the last
+	void initialize(void);								//allocates the dummy head
+	int randomLevel(void) const;						//picks the highest level for a new Node
+	CSLNode* createNode(const Object& d, int l);		//allocates a Node and copies the Object in to it
+	static void destroyNode(void* node);				//destroys and deallocates a Node
+	static size_t nodeSize(int l);						//returns the number of bytes in a Node on level l
+	static CSLNode* pointer(uintptr_t word);			//returns the Node a marked pointer points to
+	static bool isMarked(uintptr_t word);				//returns true if a marked pointer carries the mark
+
+	static const int MAX_LEVEL = 32;	//hard ceiling on the number of levels
+	double probability;					//chance of a Node being promoted to the next level
+	atomic<int> levels;					//number of levels currently in the list
+	atomic<int> count;					//number of Nodes in the master level
+	CSLNode* dummyHead;					//dummy head Node with a next pointer for every level
+	mutable SLEpochReclaimer reclaimer;	//defers deallocating unlinked Nodes
+};
+
+#endif // !concurrentskiplist_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list with a promotion probability of 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+ConcurrentSkipList<Object>::ConcurrentSkipList(void) {
+	probability = 0.5;
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list whose Nodes are promoted to the next level with a
+	chance equal to the parameter. Probabilities outside of (0, 1) fall back to 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+ConcurrentSkipList<Object>::ConcurrentSkipList(double promotion) {
+	probability = (promotion > 0.0 && promotion < 1.0) ? promotion : 0.5;
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. No other thread may be using the list. Every Node still linked on the master
+	level is deallocated here, Nodes that were removed are deallocated by the reclaimer.
+
+	POSTCONDITIONS:
+		- deallocates all dynamically allocated memory
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+ConcurrentSkipList<Object>::~ConcurrentSkipList(void) {
+	CSLNode* current = pointer(dummyHead->next[0].load());
+	while (current != NULL) {
+		CSLNode* nodeAfter = pointer(current->next[0].load());
+		destroyNode(current);
+		current = nodeAfter;
+	}
+	::operator delete(dummyHead);		//the dummy head never had an Object constructed in it
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the list.
+
+	POSTCONDITIONS:
+		- returns count
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+int ConcurrentSkipList<Object>::size(void) const {
+	return count.load();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a bool indicating if the list is empty.
+
+	POSTCONDITIONS:
+		- returns true if the list has no Nodes
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool ConcurrentSkipList<Object>::isEmpty(void) const {
+	return size() == 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target is in the list. The list is searched from the top level
+	down exactly like SkipList::contains, except that marked Nodes are stepped over instead of
+	compared. Nothing is written to the list, so contains never has to restart.
+
+	POSTCONDITIONS:
+		- returns true if a Node that is not marked contains the target
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool ConcurrentSkipList<Object>::contains(const Object& target) const {
+	SLEpochGuard guard(reclaimer);
+
+	CSLNode* current = dummyHead;
+	CSLNode* nodeAfter = NULL;
+	for (int currentLevel = levels.load() - 1; currentLevel >= 0; currentLevel--) {
+		nodeAfter = pointer(current->next[currentLevel].load(memory_order_acquire));
+		while (nodeAfter != NULL) {
+			uintptr_t word = nodeAfter->next[currentLevel].load(memory_order_acquire);
+			if (isMarked(word)) {			//steps over Nodes that are being removed
+				nodeAfter = pointer(word);
+			} else if (target > nodeAfter->data) {
+				current = nodeAfter;
+				nodeAfter = pointer(word);
+			} else {
+				break;
+			}
+		}
+	}
+
+	return nodeAfter != NULL && nodeAfter->data == target;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method takes in an Object and inserts it in to the list. If the Object is already in the list
+	the method returns false. The new Node is linked on the master level with a single compare
+	and swap, which is the point the Object becomes part of the list, and is then sewn in to each
+	level above from the bottom up. If a level changed since it was searched the list is searched
+	again and the Node is sewn in after the new predecessor. A Node that is removed before it
+	reaches its top level is left on the levels it already reached and is never sewn in higher.
+
+	POSTCONDITIONS:
+		- inserts a new Node in to the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool ConcurrentSkipList<Object>::insert(const Object& toInsert) {
+	SLEpochGuard guard(reclaimer);
+
+	CSLNode* preds[MAX_LEVEL];		//last Node before toInsert on each level
+	CSLNode* succs[MAX_LEVEL];		//first Node not before toInsert on each level
+
+	int nodeLevel = randomLevel();
+	int currentLevels = levels.load();
+	while (nodeLevel >= currentLevels && !levels.compare_exchange_weak(currentLevels, nodeLevel + 1)) {
+	}
+
+	CSLNode* newNode = NULL;
+	while (true) {
+		if (find(toInsert, preds, succs)) {		//checks if the Object is already in the list
+			if (newNode != NULL) {
+				destroyNode(newNode);	//never published, no other thread can reach it
+			}
+			return false;
+		}
+		if (newNode == NULL) {
+			newNode = createNode(toInsert, nodeLevel);
+		}
+		for (int currentLevel = 0; currentLevel <= nodeLevel; currentLevel++) {
+			newNode->next[currentLevel].store((uintptr_t)succs[currentLevel], memory_order_relaxed);
+		}
+
+		uintptr_t expected = (uintptr_t)succs[0];
+		if (preds[0]->next[0].compare_exchange_strong(expected, (uintptr_t)newNode)) {
+			break;
+		}
+	}
+	count.fetch_add(1);
+
+	//sews the new Node in to each level above the master level
+	for (int currentLevel = 1; currentLevel <= nodeLevel; currentLevel++) {
+		while (true) {
+			uintptr_t word = newNode->next[currentLevel].load();
+			if (isMarked(word)) {		//the Node is being removed
+				currentLevel = nodeLevel;
+				break;
+			}
+			if (pointer(word) != succs[currentLevel]
+				&& !newNode->next[currentLevel].compare_exchange_strong(word, (uintptr_t)succs[currentLevel])) {
+				currentLevel = nodeLevel;	//marked since it was read
+				break;
+			}
+			uintptr_t expected = (uintptr_t)succs[currentLevel];
+			if (preds[currentLevel]->next[currentLevel].compare_exchange_strong(expected, (uintptr_t)newNode)) {
+				break;
+			}
+			find(toInsert, preds, succs);	//the level changed, searches it again
+			if (succs[0] != newNode) {		//the Node was removed and snipped from the master level
+				currentLevel = nodeLevel;
+				break;
+			}
+		}
+	}
+
+	//the Node may have been removed while it was sewn in, in which case the
+	//remover could not snip it from the levels that were sewn in after it looked
+	if (isMarked(newNode->next[0].load())) {
+		find(toInsert, preds, succs);
+	}
+	release(newNode);
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the Node containing the parameter Object from the list. The Node's next
+	pointers are marked from the top level down, and the thread whose compare and swap marks the
+	master level is the one that removed the Object. The Node is then snipped from every level by
+	searching for it again.
+
+	POSTCONDITIONS:
+		- the Object is no longer in the list
+		- returns false if the Object was not in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool ConcurrentSkipList<Object>::remove(const Object& toRemove) {
+	SLEpochGuard guard(reclaimer);
+
+	CSLNode* preds[MAX_LEVEL];		//last Node before toRemove on each level
+	CSLNode* succs[MAX_LEVEL];		//first Node not before toRemove on each level
+
+	if (!find(toRemove, preds, succs)) {
+		return false;
+	}
+	CSLNode* toDelete = succs[0];
+
+	//marks every level above the master level
+	for (int currentLevel = toDelete->level; currentLevel > 0; currentLevel--) {
+		uintptr_t word = toDelete->next[currentLevel].load();
+		while (!isMarked(word) && !toDelete->next[currentLevel].compare_exchange_weak(word, word | 1)) {
+		}
+	}
+
+	//marking the master level removes the Object
+	uintptr_t word = toDelete->next[0].load();
+	while (true) {
+		if (isMarked(word)) {		//another thread removed it first
+			return false;
+		}
+		if (toDelete->next[0].compare_exchange_weak(word, word | 1)) {
+			break;
+		}
+	}
+	count.fetch_sub(1);
+
+	find(toRemove, preds, succs);	//snips the Node from every level
+	release(toDelete);
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method displays the Objects on the master level in order. Not safe to call while another
+	thread is changing the list.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void ConcurrentSkipList<Object>::show(void) const {
+	CSLNode* current = pointer(dummyHead->next[0].load());
+	while (current != NULL) {
+		cout << current->data << " ";
+		current = pointer(current->next[0].load());
+	}
+	cout << endl;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method searches for the target from the top level down and records the last Node before the
+	target in preds and the first Node not before it in succs on every level. Every marked Node
+	the search walks over is snipped out of the level with a compare and swap on the Node before
+	it. If that compare and swap fails the Node before it has changed and the search restarts
+	from the dummy head.
+
+	POSTCONDITIONS:
+		- preds and succs hold the Nodes around the target on every level in use
+		- returns true if succs[0] contains the target
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool ConcurrentSkipList<Object>::find(const Object& target, CSLNode** preds, CSLNode** succs) {
+retry:
+	CSLNode* current = dummyHead;
+	for (int currentLevel = levels.load() - 1; currentLevel >= 0; currentLevel--) {
+		CSLNode* nodeAfter = pointer(current->next[currentLevel].load(memory_order_acquire));
+		while (nodeAfter != NULL) {
+			uintptr_t word = nodeAfter->next[currentLevel].load(memory_order_acquire);
+			if (isMarked(word)) {		//snips a Node that is being removed
+				uintptr_t expected = (uintptr_t)nodeAfter;
+				if (!current->next[currentLevel].compare_exchange_strong(expected, word & ~(uintptr_t)1)) {
+					goto retry;
+				}
+				nodeAfter = pointer(word);
+			} else if (target > nodeAfter->data) {
+				current = nodeAfter;
+				nodeAfter = pointer(word);
+			} else {
+				break;
+			}
+		}
+		preds[currentLevel] = current;
+		succs[currentLevel] = nodeAfter;
+	}
+
+	return succs[0] != NULL && succs[0]->data == target;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method drops one of the two owners of a Node, the thread that inserted it and the thread that
+	removed it. Both have finished snipping the Node by the time they call release, so the Node
+	is unreachable once the second one does and is handed to the reclaimer.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void ConcurrentSkipList<Object>::release(CSLNode* node) {
+	if (node->owners.fetch_sub(1) == 1) {
+		reclaimer.retire(node, &destroyNode);
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method initializes an empty list with a dummy head that has a next pointer for every level.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void ConcurrentSkipList<Object>::initialize(void) {
+	levels.store(1);
+	count.store(0);
+	dummyHead = static_cast<CSLNode*>(::operator new(nodeSize(MAX_LEVEL - 1)));
+	dummyHead->level = MAX_LEVEL - 1;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		new (&dummyHead->next[currentLevel]) atomic<uintptr_t>(0);
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the highest level a new Node will be on, taken from one word of a generator
+	that belongs to the calling thread (see slrandom.h), but never more than one level above
+	the current top level or past MAX_LEVEL. Each thread's generator is seeded with the order
+	in which the thread first inserted, so a run with one thread always builds the same list.
+
+	POSTCONDITIONS:
+		- returns a level between 0 and levels, inclusive
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+int ConcurrentSkipList<Object>::randomLevel(void) const {
+	static atomic<uint64_t> threads(0);		//number of threads that have picked a level
+	static thread_local SLXorShift random(SLXorShift::DEFAULT_SEED + threads.fetch_add(1, memory_order_relaxed));
+	int currentLevels = levels.load(memory_order_relaxed);
+	int nodeLevel = slLevelFromWord(random(), probability);
+	if (nodeLevel > currentLevels) {
+		nodeLevel = currentLevels;
+	}
+	if (nodeLevel > MAX_LEVEL - 1) {
+		nodeLevel = MAX_LEVEL - 1;
+	}
+	return nodeLevel;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method allocates a Node on level l and copies the parameter Object in to it. The Node starts
+	out owned by both the inserting and the removing thread.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+typename ConcurrentSkipList<Object>::CSLNode* ConcurrentSkipList<Object>::createNode(const Object& d, int l) {
+	CSLNode* newNode = static_cast<CSLNode*>(::operator new(nodeSize(l)));
+	new (&newNode->data) Object(d);		//copies the Object in to the Node
+	newNode->level = l;
+	new (&newNode->owners) atomic<int>(2);
+	for (int currentLevel = 0; currentLevel <= l; currentLevel++) {
+		new (&newNode->next[currentLevel]) atomic<uintptr_t>(0);
+	}
+	return newNode;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method destroys the Object in a Node and deallocates it. Passed to the reclaimer for Nodes
+	that have been removed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void ConcurrentSkipList<Object>::destroyNode(void* node) {
+	static_cast<CSLNode*>(node)->data.~Object();
+	::operator delete(node);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of bytes in a Node on level l, rounded up to the alignment of a
+	Node.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+size_t ConcurrentSkipList<Object>::nodeSize(int l) {
+	size_t bytes = sizeof(CSLNode) + l * sizeof(atomic<uintptr_t>);
+	return (bytes + alignof(CSLNode) - 1) / alignof(CSLNode) * alignof(CSLNode);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the Node a marked pointer points to, without the mark.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+typename ConcurrentSkipList<Object>::CSLNode* ConcurrentSkipList<Object>::pointer(uintptr_t word) {
+	return reinterpret_cast<CSLNode*>(word & ~(uintptr_t)1);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the Node owning a marked pointer is being removed on that level.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool ConcurrentSkipList<Object>::isMarked(uintptr_t word) {
+	return (word & 1) != 0;
+};
@@ -0,0 +1,543 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing a lazy Skip List for read-mostly workloads that are shared between threads. It has the
+	same insert, remove, and contains contract as SkipList and stores every Object once in a tower Node.
+
+	Readers take no locks and never write to the list, so contains never blocks or restarts. Writers search the list the same way
+	without locks, then lock only the Nodes before the Object on each level they change, check that those Nodes are still in the list
+	and still point where the search found them, and retry the search if not. Every Node has two flags: marked is set when the Node is
+	removed, before it is unlinked, and fullyLinked is set once an insert has linked the Node on every level it is on. An Object is in
+	the list when its Node is fullyLinked and not marked, so contains only has to read the two flags of the Node it finds. Next pointers
+	and fullyLinked are published with release stores and read with acquire loads, so a reader that reaches a Node always sees the
+	Object and the pointers that were written before it.
+
+	Removed Nodes are handed to an SLEpochReclaimer (see slepoch.h) once they are unlinked from every level, so remove never
+	deallocates a Node that a reader is still on.
+
+	ConcurrentSkipList (see concurrentskiplist.h) is lock-free for writers as well. LazySkipList makes writes wait on each other when
+	they change the same Nodes, in exchange for the simplest read path and no retries for readers.
+
+	NOTE:	Objects are responsible for having overloaded equality and greater than operators for comparison.
+
+	NOTE:	size may be briefly off by the number of running inserts and removes. The number of levels only grows, and Nodes are
+			allocated with the global operator new.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef lazyskiplist_h
+#define lazyskiplist_h
+
+//imports libraries
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <thread>
+#include "slepoch.h"
+#include "slrandom.h"
+
+using namespace std;
+
+template<class Object>
+
+class LazySkipList {
+
+	private:
+
+	struct LSLNode {
+
+		Object data;				//Object data member, stored inline
+		int level;					//highest level that the Node is on
+		atomic<bool> locked;		//true while a writer holds the Node's lock
+		atomic<bool> marked;		//true once the Node is being removed
+		atomic<bool> fullyLinked;	//true once the Node is linked on every level it is on
+		atomic<LSLNode*> next[1];	//Node pointers to the Node after the Node, one per level.
+									//Allocated with level + 1 entries
+	};
+
+	public:
+
+	LazySkipList(void);									//Default no-args contructor
+	explicit LazySkipList(double promotion);			//constructor taking the promotion probability
+	~LazySkipList(void);								//Destructor, no other thread may use the list
+	int size(void) const;								//returns size of the list
+	bool isEmpty(void) const;							//returns bool indicating if there are any Nodes in the list
+	bool contains(const Object& target) const;			//returns true if the target object is in the list
+	bool insert(const Object& toInsert);				//inserts a new Node with the parameter Object
+	bool remove(const Object& toRemove);				//removes Node with data equal to the parameter Object
+	void show(void) const;								//displays the list, no other thread may change the list
+
+	private:
+
+	LazySkipList(const LazySkipList&);					//not copyable
+	LazySkipList& operator=(const LazySkipList&);		//not copyable
+	int find(const Object& target, LSLNode** preds, LSLNode** succs) const;	//records the Nodes around target
+	int lockPredecessors(LSLNode** preds, LSLNode** succs, int topLevel, LSLNode* toDelete, bool& valid);	//locks and checks the Nodes before a change
+	void unlockPredecessors(LSLNode** preds, int highestLocked);	//unlocks the Nodes locked by lockPredecessors
+	static void lockNode(LSLNode* node);				//spins until the Node's lock is taken
+	static void unlockNode(LSLNode* node);				//gives the Node's lock back
+	void initialize(void);								//allocates the dummy head
+	int randomLevel(void) const;						//picks the highest level for a new Node
+	LSLNode* createNode(const Object& d, int l);		//allocates a Node and copies the Object in to it
+	static void destroyNode(void* node);				//destroys and deallocates a Node
+	static size_t nodeSize(int l);						//returns the number of bytes in a Node on level l
+
+	static const int MAX_LEVEL = 32;	//hard ceiling on the number of levels
+	double probability;					//chance of a Node being promoted to the next level
+	atomic<int> levels;					//number of levels currently in the list
+	atomic<int> count;					//number of Nodes in the master level
+	LSLNode* dummyHead;					//dummy head Node with a next pointer for every level
+	mutable SLEpochReclaimer reclaimer;	//defers deallocating unlinked Nodes
+};
+
+#endif // !lazyskiplist_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list with a promotion probability of 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+LazySkipList<Object>::LazySkipList(void) {
+	probability = 0.5;
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list whose Nodes are promoted to the next level with a
+	chance equal to the parameter. Probabilities outside of (0, 1) fall back to 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+LazySkipList<Object>::LazySkipList(double promotion) {
+	probability = (promotion > 0.0 && promotion < 1.0) ? promotion : 0.5;
+	initialize();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. No other thread may be using the list. Every Node still linked on the master
+	level is deallocated here, Nodes that were removed are deallocated by the reclaimer.
+
+	POSTCONDITIONS:
+		- deallocates all dynamically allocated memory
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+LazySkipList<Object>::~LazySkipList(void) {
+	LSLNode* current = dummyHead->next[0].load();
+	while (current != NULL) {
+		LSLNode* nodeAfter = current->next[0].load();
+		destroyNode(current);
+		current = nodeAfter;
+	}
+	::operator delete(dummyHead);		//the dummy head never had an Object constructed in it
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the list.
+
+	POSTCONDITIONS:
+		- returns count
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+int LazySkipList<Object>::size(void) const {
+	return count.load();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a bool indicating if the list is empty.
+
+	POSTCONDITIONS:
+		- returns true if the list has no Nodes
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool LazySkipList<Object>::isEmpty(void) const {
+	return size() == 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target is in the list. The list is searched once from the top
+	level down without taking any locks, and the Node found holds the target if it is fully
+	linked and not marked. contains never waits on a writer.
+
+	POSTCONDITIONS:
+		- returns true if the target is in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool LazySkipList<Object>::contains(const Object& target) const {
+	SLEpochGuard guard(reclaimer);
+
+	LSLNode* current = dummyHead;
+	for (int currentLevel = levels.load(memory_order_acquire) - 1; currentLevel >= 0; currentLevel--) {
+		LSLNode* nodeAfter = current->next[currentLevel].load(memory_order_acquire);
+		while (nodeAfter != NULL && target > nodeAfter->data) {
+			current = nodeAfter;
+			nodeAfter = current->next[currentLevel].load(memory_order_acquire);
+		}
+		if (nodeAfter != NULL && nodeAfter->data == target) {	//the first level the target is found on decides
+			return nodeAfter->fullyLinked.load(memory_order_acquire) && !nodeAfter->marked.load(memory_order_acquire);
+		}
+	}
+	return false;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method takes in an Object and inserts it in to the list. If the Object is already in the list
+	the method returns false, after waiting for the insert that added it to finish so that a
+	following contains finds it. Otherwise the Nodes before the Object on each level of the new
+	Node are locked and checked, the new Node is linked in from the bottom up with release
+	stores, and it is published by setting fullyLinked.
+
+	POSTCONDITIONS:
+		- inserts a new Node in to the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool LazySkipList<Object>::insert(const Object& toInsert) {
+	SLEpochGuard guard(reclaimer);
+
+	LSLNode* preds[MAX_LEVEL];		//last Node before toInsert on each level
+	LSLNode* succs[MAX_LEVEL];		//first Node not before toInsert on each level
+
+	int nodeLevel = randomLevel();
+	int currentLevels = levels.load();
+	while (nodeLevel >= currentLevels && !levels.compare_exchange_weak(currentLevels, nodeLevel + 1)) {
+	}
+
+	while (true) {
+		int levelFound = find(toInsert, preds, succs);
+		if (levelFound != -1) {		//checks if the Object is already in the list
+			LSLNode* nodeFound = succs[levelFound];
+			if (!nodeFound->marked.load(memory_order_acquire)) {
+				while (!nodeFound->fullyLinked.load(memory_order_acquire)) {
+					this_thread::yield();
+				}
+				return false;
+			}
+			continue;		//the Node found is being removed, searches again once it is gone
+		}
+
+		bool valid = true;
+		int highestLocked = lockPredecessors(preds, succs, nodeLevel, NULL, valid);
+		if (!valid) {
+			unlockPredecessors(preds, highestLocked);
+			continue;
+		}
+
+		LSLNode* newNode = createNode(toInsert, nodeLevel);
+		for (int currentLevel = 0; currentLevel <= nodeLevel; currentLevel++) {
+			newNode->next[currentLevel].store(succs[currentLevel], memory_order_relaxed);
+		}
+		for (int currentLevel = 0; currentLevel <= nodeLevel; currentLevel++) {
+			preds[currentLevel]->next[currentLevel].store(newNode, memory_order_release);
+		}
+		newNode->fullyLinked.store(true, memory_order_release);
+		count.fetch_add(1);
+
+		unlockPredecessors(preds, highestLocked);
+		return true;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the Node containing the parameter Object from the list. The Node is locked and
+	marked, which removes the Object, then the Nodes before it on each level are locked and
+	checked and the Node is unlinked from the top level down. The unlinked Node is retired to the
+	reclaimer instead of being deallocated, since readers may still be on it.
+
+	POSTCONDITIONS:
+		- the Object is no longer in the list
+		- returns false if the Object was not in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+bool LazySkipList<Object>::remove(const Object& toRemove) {
+	SLEpochGuard guard(reclaimer);
+
+	LSLNode* preds[MAX_LEVEL];		//last Node before toRemove on each level
+	LSLNode* succs[MAX_LEVEL];		//first Node not before toRemove on each level
+	LSLNode* toDelete = NULL;		//Node this thread marked
+
+	while (true) {
+		int levelFound = find(toRemove, preds, succs);
+		if (toDelete == NULL) {
+			if (levelFound == -1) {
+				return false;
+			}
+			LSLNode* nodeFound = succs[levelFound];
+			//only a Node that is fully linked and found on its top level can be removed, otherwise
+			//its insert is still running or its remove has already started
+			if (!nodeFound->fullyLinked.load(memory_order_acquire) || nodeFound->level != levelFound
+				|| nodeFound->marked.load(memory_order_acquire)) {
+				return false;
+			}
+			lockNode(nodeFound);
+			if (nodeFound->marked.load(memory_order_relaxed)) {		//another thread removed it first
+				unlockNode(nodeFound);
+				return false;
+			}
+			nodeFound->marked.store(true, memory_order_release);
+			toDelete = nodeFound;
+			count.fetch_sub(1);
+		}
+
+		bool valid = true;
+		int highestLocked = lockPredecessors(preds, succs, toDelete->level, toDelete, valid);
+		if (!valid) {
+			unlockPredecessors(preds, highestLocked);
+			continue;
+		}
+
+		for (int currentLevel = toDelete->level; currentLevel >= 0; currentLevel--) {
+			preds[currentLevel]->next[currentLevel].store(toDelete->next[currentLevel].load(memory_order_relaxed), memory_order_release);
+		}
+		unlockNode(toDelete);
+		unlockPredecessors(preds, highestLocked);
+		reclaimer.retire(toDelete, &destroyNode);
+		return true;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method displays the Objects on the master level in order. Not safe to call while another
+	thread is changing the list.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void LazySkipList<Object>::show(void) const {
+	LSLNode* current = dummyHead->next[0].load();
+	while (current != NULL) {
+		cout << current->data << " ";
+		current = current->next[0].load();
+	}
+	cout << endl;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method searches for the target from the top level down without taking any locks, and records
+	the last Node before the target in preds and the first Node not before it in succs on every
+	level in use. Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- preds and succs hold the Nodes around the target on every level in use
+		- returns the highest level the target was found on, or -1
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+int LazySkipList<Object>::find(const Object& target, LSLNode** preds, LSLNode** succs) const {
+	int levelFound = -1;
+	LSLNode* current = dummyHead;
+	for (int currentLevel = levels.load(memory_order_acquire) - 1; currentLevel >= 0; currentLevel--) {
+		LSLNode* nodeAfter = current->next[currentLevel].load(memory_order_acquire);
+		while (nodeAfter != NULL && target > nodeAfter->data) {
+			current = nodeAfter;
+			nodeAfter = current->next[currentLevel].load(memory_order_acquire);
+		}
+		if (levelFound == -1 && nodeAfter != NULL && nodeAfter->data == target) {
+			levelFound = currentLevel;
+		}
+		preds[currentLevel] = current;
+		succs[currentLevel] = nodeAfter;
+	}
+	return levelFound;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method locks the Node before the change on each level from the master level up to topLevel.
+	A Node that is the predecessor on several levels is locked once. Locks are always taken from
+	the master level up, which is from the largest Object down, so writers never deadlock. valid
+	is set to false if a locked Node has been marked or has changed since the search. For an
+	insert toDelete is NULL and each locked Node must still point to an unmarked Node in succs,
+	for a remove each locked Node must still point to toDelete.
+
+	POSTCONDITIONS:
+		- returns the highest level whose predecessor was locked, to pass to unlockPredecessors
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+int LazySkipList<Object>::lockPredecessors(LSLNode** preds, LSLNode** succs, int topLevel, LSLNode* toDelete, bool& valid) {
+	int highestLocked = -1;
+	LSLNode* previous = NULL;
+	for (int currentLevel = 0; valid && currentLevel <= topLevel; currentLevel++) {
+		LSLNode* pred = preds[currentLevel];
+		LSLNode* succ = (toDelete != NULL) ? toDelete : succs[currentLevel];
+		if (pred != previous) {
+			lockNode(pred);
+			highestLocked = currentLevel;
+			previous = pred;
+		}
+		valid = !pred->marked.load(memory_order_acquire)
+			&& pred->next[currentLevel].load(memory_order_acquire) == succ
+			&& (toDelete != NULL || succ == NULL || !succ->marked.load(memory_order_acquire));
+	}
+	return highestLocked;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method unlocks the Nodes locked by lockPredecessors, each one once.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void LazySkipList<Object>::unlockPredecessors(LSLNode** preds, int highestLocked) {
+	LSLNode* previous = NULL;
+	for (int currentLevel = 0; currentLevel <= highestLocked; currentLevel++) {
+		if (preds[currentLevel] != previous) {
+			unlockNode(preds[currentLevel]);
+			previous = preds[currentLevel];
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method spins until it takes the lock of the parameter Node, yielding between attempts.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void LazySkipList<Object>::lockNode(LSLNode* node) {
+	while (node->locked.exchange(true, memory_order_acquire)) {
+		while (node->locked.load(memory_order_relaxed)) {
+			this_thread::yield();
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method gives back the lock of the parameter Node.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void LazySkipList<Object>::unlockNode(LSLNode* node) {
+	node->locked.store(false, memory_order_release);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method initializes an empty list with a dummy head that has a next pointer for every level.
+	The dummy head has its own lock and is never marked.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void LazySkipList<Object>::initialize(void) {
+	levels.store(1);
+	count.store(0);
+	dummyHead = static_cast<LSLNode*>(::operator new(nodeSize(MAX_LEVEL - 1)));
+	dummyHead->level = MAX_LEVEL - 1;
+	new (&dummyHead->locked) atomic<bool>(false);
+	new (&dummyHead->marked) atomic<bool>(false);
+	new (&dummyHead->fullyLinked) atomic<bool>(true);
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		new (&dummyHead->next[currentLevel]) atomic<LSLNode*>(NULL);
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the highest level a new Node will be on, taken from one word of a generator
+	that belongs to the calling thread (see slrandom.h), but never more than one level above
+	the current top level or past MAX_LEVEL. Each thread's generator is seeded with the order
+	in which the thread first inserted, so a run with one thread always builds the same list.
+
+	POSTCONDITIONS:
+		- returns a level between 0 and levels, inclusive
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+int LazySkipList<Object>::randomLevel(void) const {
+	static atomic<uint64_t> threads(0);		//number of threads that have picked a level
+	static thread_local SLXorShift random(SLXorShift::DEFAULT_SEED + threads.fetch_add(1, memory_order_relaxed));
+	int currentLevels = levels.load(memory_order_relaxed);
+	int nodeLevel = slLevelFromWord(random(), probability);
+	if (nodeLevel > currentLevels) {
+		nodeLevel = currentLevels;
+	}
+	if (nodeLevel > MAX_LEVEL - 1) {
+		nodeLevel = MAX_LEVEL - 1;
+	}
+	return nodeLevel;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method allocates an unlocked, unmarked Node on level l and copies the parameter Object in to
+	it. The Node is not fully linked until insert publishes it.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+typename LazySkipList<Object>::LSLNode* LazySkipList<Object>::createNode(const Object& d, int l) {
+	LSLNode* newNode = static_cast<LSLNode*>(::operator new(nodeSize(l)));
+	new (&newNode->data) Object(d);		//copies the Object in to the Node
+	newNode->level = l;
+	new (&newNode->locked) atomic<bool>(false);
+	new (&newNode->marked) atomic<bool>(false);
+	new (&newNode->fullyLinked) atomic<bool>(false);
+	for (int currentLevel = 0; currentLevel <= l; currentLevel++) {
+		new (&newNode->next[currentLevel]) atomic<LSLNode*>(NULL);
+	}
+	return newNode;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method destroys the Object in a Node and deallocates it. Passed to the reclaimer for Nodes
+	that have been removed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void LazySkipList<Object>::destroyNode(void* node) {
+	static_cast<LSLNode*>(node)->data.~Object();
+	::operator delete(node);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of bytes in a Node on level l, rounded up to the alignment of a
+	Node.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+size_t LazySkipList<Object>::nodeSize(int l) {
+	size_t bytes = sizeof(LSLNode) + l * sizeof(atomic<LSLNode*>);
+	return (bytes + alignof(LSLNode) - 1) / alignof(LSLNode) * alignof(LSLNode);
+};
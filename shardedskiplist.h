@@ -0,0 +1,798 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing a range partitioned Skip List for sharing one ordered set between threads. The Objects
+	are split by range across a fixed number of shards, each an indexed SkipList (see skiplist.h) with its own reader/writer lock, so
+	writes to different ranges never wait on each other and reads of one shard run side by side.
+
+	A routing table holds the smallest Object of every shard after the first, and a point operation binary searches it for the
+	shard that owns the Object, locks only that shard, and runs the SkipList operation. Routing tables are never changed in place.
+	Rebalancing builds a new table and publishes it with one atomic store while it holds the locks of the shards it changed, and
+	the old table is handed to an SLEpochReclaimer (see slepoch.h) so it is not deallocated while another thread is reading it. An
+	operation that took its shard lock checks that the table it routed with is still the current one and routes again if not.
+
+	Shards come in to use as the list grows: at first every Object is routed to shard 0. Every CHECK_EVERY inserts a shard checks
+	whether it holds more than SKEW times the average number of Objects per shard (and at least MIN_SHARD_SIZE), and if so half of
+	the difference is moved to its smaller neighbor, which may be the next unused shard. Moving a range uses SkipList::split and
+	SkipList::join, which relink one pointer per level, and the indexed shards find the Object to cut at by position in O(logn), so
+	rebalancing holds two shard locks for microseconds. rebalance evens out every shard at once.
+
+	insert_batch, remove_batch, and contains_batch sort a batch, lock each shard it touches once, and pass the part of the batch for
+	each shard to the batch methods of the SkipList. for_each_in_range and range hold read locks on every shard the range touches for
+	the whole scan, so they see one consistent state of the list. range copies the part of each shard on its own thread when the range
+	holds at least PARALLEL_SCAN Objects, then joins the parts in order, which needs no merging since shards never overlap.
+
+	NOTE:	The comparator must be a strict weak ordering. Objects must be copyable, since the routing table holds copies of them.
+
+	NOTE:	size is the sum of per-shard counts and may be briefly off while other threads are changing the list.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef shardedskiplist_h
+#define shardedskiplist_h
+
+//imports libraries
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "skiplist.h"
+#include "slepoch.h"
+
+using namespace std;
+
+template<class Object, class Compare = less<Object> >
+
+class ShardedSkipList {
+
+	private:
+
+	typedef SkipList<Object, Compare, SLPoolAllocator, true> SSLList;	//indexed so a range can be cut by position
+
+	struct alignas(64) SSLShard {
+
+		mutable shared_mutex lock;	//held shared by readers and exclusively by writers of the shard
+		SSLList list;				//Objects routed to the shard
+		atomic<int> count;			//size of list, readable without the lock
+		int sinceCheck;				//inserts since the shard last checked for skew, guarded by lock
+
+		SSLShard() : count(0), sinceCheck(0) {};
+	};
+
+	struct SSLRouting {
+
+		vector<Object> bounds;		//bounds[i] is the smallest Object routed to shard i + 1
+
+		int route(const Object& key, const Compare& compare) const {	//returns the shard that owns key
+			return (int)(upper_bound(bounds.begin(), bounds.end(), key, compare) - bounds.begin());
+		};
+	};
+
+	public:
+
+	static const int CHECK_EVERY = 256;			//inserts in to a shard between checks for skew
+	static const int MIN_SHARD_SIZE = 1024;		//shards smaller than this are never split up
+	static constexpr double SKEW = 2.0;			//a shard holding this many times the average is rebalanced
+	static const int PARALLEL_SCAN = 65536;		//ranges of at least this many Objects are copied on several threads
+
+	explicit ShardedSkipList(int shardCount = 0, const Compare& comp = Compare());	//constructor, 0 shards means one per hardware thread
+	~ShardedSkipList(void);								//Destructor, no other thread may use the list
+	int size(void) const;								//returns the number of Objects in every shard
+	bool isEmpty(void) const;							//returns true if every shard is empty
+	int shards(void) const;								//returns the number of shards
+	int shardSize(int shard) const;						//returns the number of Objects in one shard
+	double skew(void) const;							//returns the size of the largest shard over the average
+	bool contains(const Object& target) const;			//returns true if the target is in the list
+	bool insert(const Object& toInsert);				//inserts the Object, false if it is already in the list
+	bool remove(const Object& toRemove);				//removes the Object, false if it is not in the list
+	template<class InputIterator, class OutputIterator>
+	int contains_batch(InputIterator first, InputIterator last, OutputIterator found) const;	//looks up a batch of Objects
+	template<class InputIterator>
+	int insert_batch(InputIterator first, InputIterator last);	//inserts a batch of Objects
+	template<class InputIterator>
+	int remove_batch(InputIterator first, InputIterator last);	//removes a batch of Objects
+	template<class Function>
+	void for_each_in_range(const Object& low, const Object& high, Function visit) const;	//calls visit on each Object in [low, high)
+	vector<Object> range(const Object& low, const Object& high) const;	//returns a copy of every Object in [low, high)
+	void rebalance(void);								//evens out the number of Objects in every shard
+	void makeEmpty(void);								//removes every Object
+
+	private:
+
+	ShardedSkipList(const ShardedSkipList&);			//not copyable
+	ShardedSkipList& operator=(const ShardedSkipList&);	//not copyable
+	vector<int> routeBatch(const vector<Object>& batch, const SSLRouting* table) const;	//returns the shard of each sorted Object
+	void checkSkew(int shard);							//moves part of a skewed shard to its smaller neighbor
+	void moveUp(int shard, int toMove, SSLRouting* table);	//moves the largest Objects of a shard to the next shard
+	void moveDown(int shard, int toMove, SSLRouting* table);	//moves the smallest Objects of a shard to the shard before
+	void publish(SSLRouting* table);					//makes a new routing table current and retires the old one
+	static void destroyRouting(void* table);			//deallocates a retired routing table
+
+	Compare compare;					//orders the Objects in the list
+	int shardCount;						//number of shards
+	SSLShard* shardArray;				//the shards, in order of the ranges they own
+	atomic<SSLRouting*> routing;		//current routing table
+	mutex rebalancing;					//held while shards are being rebalanced
+	mutable SLEpochReclaimer reclaimer;	//defers deallocating replaced routing tables
+};
+
+#endif // !shardedskiplist_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list with the parameter number of shards, one per
+	hardware thread if it is not positive, ordered with the parameter comparator. Every Object
+	is routed to shard 0 until the list grows.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+ShardedSkipList<Object, Compare>::ShardedSkipList(int shardCount, const Compare& comp) : compare(comp) {
+	if (shardCount < 1) {
+		shardCount = (int)thread::hardware_concurrency();
+		if (shardCount < 1) {
+			shardCount = 4;
+		}
+	}
+	this->shardCount = shardCount;
+	shardArray = new SSLShard[shardCount];
+	routing.store(new SSLRouting());
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. No other thread may be using the list. Deletes every shard and the current
+	routing table, replaced tables are deallocated by the reclaimer.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+ShardedSkipList<Object, Compare>::~ShardedSkipList(void) {
+	delete[] shardArray;
+	delete routing.load();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the list, the sum of the counts of every shard.
+	Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+int ShardedSkipList<Object, Compare>::size(void) const {
+	int total = 0;
+	for (int shard = 0; shard < shardCount; shard++) {
+		total += shardArray[shard].count.load(memory_order_relaxed);
+	}
+	return total;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if there are no Objects in any shard. Method cannot change any data
+	members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+bool ShardedSkipList<Object, Compare>::isEmpty(void) const {
+	return size() == 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of shards the list was built with. Method cannot change any data
+	members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+int ShardedSkipList<Object, Compare>::shards(void) const {
+	return shardCount;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the parameter shard, 0 if there is no such shard.
+	Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+int ShardedSkipList<Object, Compare>::shardSize(int shard) const {
+	if (shard < 0 || shard >= shardCount) {
+		return 0;
+	}
+	return shardArray[shard].count.load(memory_order_relaxed);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the largest shard divided by the average number of
+	Objects per shard, 1.0 for an even list and shardCount when one shard holds everything.
+	Returns 1.0 for an empty list. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+double ShardedSkipList<Object, Compare>::skew(void) const {
+	int total = 0;
+	int largest = 0;
+	for (int shard = 0; shard < shardCount; shard++) {
+		int count = shardArray[shard].count.load(memory_order_relaxed);
+		total += count;
+		largest = max(largest, count);
+	}
+	return (total == 0) ? 1.0 : (double)largest * shardCount / total;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target parameter is in the list. The target is routed to its
+	shard, which is searched under a read lock. Routes again if the routing table changed
+	before the lock was taken. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+bool ShardedSkipList<Object, Compare>::contains(const Object& target) const {
+	SLEpochGuard guard(reclaimer);
+	while (true) {
+		const SSLRouting* table = routing.load(memory_order_acquire);
+		SSLShard& shard = shardArray[table->route(target, compare)];
+		shared_lock<shared_mutex> hold(shard.lock);
+		if (routing.load(memory_order_acquire) == table) {
+			return shard.list.contains(target);
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method inserts the parameter Object in to the shard it is routed to, under the write lock
+	of that shard. Every CHECK_EVERY inserts in to a shard, the shard is checked for skew once
+	its lock is released. Returns false if the Object is already in the list.
+
+	POSTCONDITIONS:
+		- the Object is in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+bool ShardedSkipList<Object, Compare>::insert(const Object& toInsert) {
+	int routed;
+	bool inserted;
+	bool check = false;
+	{
+		SLEpochGuard guard(reclaimer);
+		while (true) {
+			const SSLRouting* table = routing.load(memory_order_acquire);
+			routed = table->route(toInsert, compare);
+			SSLShard& shard = shardArray[routed];
+			unique_lock<shared_mutex> hold(shard.lock);
+			if (routing.load(memory_order_acquire) != table) {
+				continue;
+			}
+			inserted = shard.list.insert(toInsert);
+			if (inserted) {
+				shard.count.store(shard.list.size(), memory_order_relaxed);
+				if (++shard.sinceCheck >= CHECK_EVERY) {
+					shard.sinceCheck = 0;
+					check = true;
+				}
+			}
+			break;
+		}
+	}
+	if (check) {
+		checkSkew(routed);
+	}
+	return inserted;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the parameter Object from the shard it is routed to, under the write lock of
+	that shard. Returns false if the Object is not in the list.
+
+	POSTCONDITIONS:
+		- the Object is not in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+bool ShardedSkipList<Object, Compare>::remove(const Object& toRemove) {
+	SLEpochGuard guard(reclaimer);
+	while (true) {
+		const SSLRouting* table = routing.load(memory_order_acquire);
+		SSLShard& shard = shardArray[table->route(toRemove, compare)];
+		unique_lock<shared_mutex> hold(shard.lock);
+		if (routing.load(memory_order_acquire) != table) {
+			continue;
+		}
+		bool removed = shard.list.remove(toRemove);
+		shard.count.store(shard.list.size(), memory_order_relaxed);
+		return removed;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the shard each Object of a sorted batch is routed to by the parameter routing
+	table. The shards never decrease along the batch. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+vector<int> ShardedSkipList<Object, Compare>::routeBatch(const vector<Object>& batch, const SSLRouting* table) const {
+	vector<int> routed(batch.size());
+	for (size_t i = 0; i < batch.size(); i++) {
+		routed[i] = table->route(batch[i], compare);
+	}
+	return routed;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method looks up every Object in the range [first, last) and writes one bool per Object to
+	found, in the order of the range. The batch is sorted, each shard it touches is read locked
+	once, and the part of the batch for each shard is passed to SkipList::contains_batch.
+	Returns the number of Objects found. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+template<class InputIterator, class OutputIterator>
+int ShardedSkipList<Object, Compare>::contains_batch(InputIterator first, InputIterator last, OutputIterator found) const {
+	vector<Object> arrival(first, last);
+	vector<size_t> order(arrival.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		order[i] = i;
+	}
+	sort(order.begin(), order.end(), [&](size_t a, size_t b) { return compare(arrival[a], arrival[b]); });
+	vector<Object> batch;
+	batch.reserve(arrival.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		batch.push_back(arrival[order[i]]);
+	}
+
+	vector<bool> sortedFound;
+	SLEpochGuard guard(reclaimer);
+	while (true) {
+		const SSLRouting* table = routing.load(memory_order_acquire);
+		vector<int> routed = routeBatch(batch, table);
+		vector<shared_lock<shared_mutex> > held;
+		for (size_t i = 0; i < batch.size(); i++) {
+			if (i == 0 || routed[i] != routed[i - 1]) {
+				held.push_back(shared_lock<shared_mutex>(shardArray[routed[i]].lock));
+			}
+		}
+		if (routing.load(memory_order_acquire) != table) {
+			continue;
+		}
+		sortedFound.clear();
+		for (size_t start = 0; start < batch.size(); ) {
+			size_t end = start;
+			while (end < batch.size() && routed[end] == routed[start]) {
+				end++;
+			}
+			shardArray[routed[start]].list.contains_batch(batch.begin() + start, batch.begin() + end, back_inserter(sortedFound));
+			start = end;
+		}
+		break;
+	}
+
+	vector<bool> results(arrival.size());
+	int hits = 0;
+	for (size_t i = 0; i < order.size(); i++) {
+		results[order[i]] = sortedFound[i];
+		hits += sortedFound[i];
+	}
+	for (size_t i = 0; i < results.size(); i++) {
+		*found++ = results[i];
+	}
+	return hits;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method inserts every Object in the range [first, last). The batch is sorted, each shard it
+	touches is write locked once, in order, and the part of the batch for each shard is passed
+	to SkipList::insert_batch. The shards that grew by at least CHECK_EVERY since their last
+	check are checked for skew once the locks are released. Returns the number of Objects
+	inserted.
+
+	POSTCONDITIONS:
+		- every Object in the range is in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+template<class InputIterator>
+int ShardedSkipList<Object, Compare>::insert_batch(InputIterator first, InputIterator last) {
+	vector<Object> batch(first, last);
+	sort(batch.begin(), batch.end(), compare);
+	int inserted = 0;
+	vector<int> toCheck;
+	{
+		SLEpochGuard guard(reclaimer);
+		while (true) {
+			const SSLRouting* table = routing.load(memory_order_acquire);
+			vector<int> routed = routeBatch(batch, table);
+			vector<unique_lock<shared_mutex> > held;
+			for (size_t i = 0; i < batch.size(); i++) {
+				if (i == 0 || routed[i] != routed[i - 1]) {
+					held.push_back(unique_lock<shared_mutex>(shardArray[routed[i]].lock));
+				}
+			}
+			if (routing.load(memory_order_acquire) != table) {
+				continue;
+			}
+			for (size_t start = 0; start < batch.size(); ) {
+				size_t end = start;
+				while (end < batch.size() && routed[end] == routed[start]) {
+					end++;
+				}
+				SSLShard& shard = shardArray[routed[start]];
+				int added = shard.list.insert_batch(batch.begin() + start, batch.begin() + end);
+				shard.count.store(shard.list.size(), memory_order_relaxed);
+				inserted += added;
+				shard.sinceCheck += added;
+				if (shard.sinceCheck >= CHECK_EVERY) {
+					shard.sinceCheck = 0;
+					toCheck.push_back(routed[start]);
+				}
+				start = end;
+			}
+			break;
+		}
+	}
+	for (size_t i = 0; i < toCheck.size(); i++) {
+		checkSkew(toCheck[i]);
+	}
+	return inserted;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object in the range [first, last) that is in the list. The batch is
+	sorted, each shard it touches is write locked once, in order, and the part of the batch for
+	each shard is passed to SkipList::remove_batch. Returns the number of Objects removed.
+
+	POSTCONDITIONS:
+		- no Object in the range is in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+template<class InputIterator>
+int ShardedSkipList<Object, Compare>::remove_batch(InputIterator first, InputIterator last) {
+	vector<Object> batch(first, last);
+	sort(batch.begin(), batch.end(), compare);
+	SLEpochGuard guard(reclaimer);
+	while (true) {
+		const SSLRouting* table = routing.load(memory_order_acquire);
+		vector<int> routed = routeBatch(batch, table);
+		vector<unique_lock<shared_mutex> > held;
+		for (size_t i = 0; i < batch.size(); i++) {
+			if (i == 0 || routed[i] != routed[i - 1]) {
+				held.push_back(unique_lock<shared_mutex>(shardArray[routed[i]].lock));
+			}
+		}
+		if (routing.load(memory_order_acquire) != table) {
+			continue;
+		}
+		int removed = 0;
+		for (size_t start = 0; start < batch.size(); ) {
+			size_t end = start;
+			while (end < batch.size() && routed[end] == routed[start]) {
+				end++;
+			}
+			SSLShard& shard = shardArray[routed[start]];
+			removed += shard.list.remove_batch(batch.begin() + start, batch.begin() + end);
+			shard.count.store(shard.list.size(), memory_order_relaxed);
+			start = end;
+		}
+		return removed;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method calls visit on every Object in the half-open range [low, high) in ascending order.
+	Every shard the range touches is read locked, in order, for the whole scan, so no Object can
+	move between shards or change while it runs. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+template<class Function>
+void ShardedSkipList<Object, Compare>::for_each_in_range(const Object& low, const Object& high, Function visit) const {
+	if (!compare(low, high)) {
+		return;
+	}
+	SLEpochGuard guard(reclaimer);
+	while (true) {
+		const SSLRouting* table = routing.load(memory_order_acquire);
+		int firstShard = table->route(low, compare);
+		int lastShard = table->route(high, compare);
+		vector<shared_lock<shared_mutex> > held;
+		for (int shard = firstShard; shard <= lastShard; shard++) {
+			held.push_back(shared_lock<shared_mutex>(shardArray[shard].lock));
+		}
+		if (routing.load(memory_order_acquire) != table) {
+			continue;
+		}
+		for (int shard = firstShard; shard <= lastShard; shard++) {
+			shardArray[shard].list.for_each_in_range(low, high, visit);
+		}
+		return;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a copy of every Object in the half-open range [low, high) in ascending order.
+	Every shard the range touches is read locked, in order, for the whole scan. The number of
+	Objects in the range is found from the ranks of low and high in each shard, and when it is
+	at least PARALLEL_SCAN the part of each shard is copied on its own thread. The parts are
+	then joined in shard order. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+vector<Object> ShardedSkipList<Object, Compare>::range(const Object& low, const Object& high) const {
+	vector<Object> result;
+	if (!compare(low, high)) {
+		return result;
+	}
+	SLEpochGuard guard(reclaimer);
+	while (true) {
+		const SSLRouting* table = routing.load(memory_order_acquire);
+		int firstShard = table->route(low, compare);
+		int lastShard = table->route(high, compare);
+		vector<shared_lock<shared_mutex> > held;
+		for (int shard = firstShard; shard <= lastShard; shard++) {
+			held.push_back(shared_lock<shared_mutex>(shardArray[shard].lock));
+		}
+		if (routing.load(memory_order_acquire) != table) {
+			continue;
+		}
+
+		int parts = lastShard - firstShard + 1;
+		vector<vector<Object> > copies(parts);
+		int total = 0;
+		for (int part = 0; part < parts; part++) {
+			const SSLList& list = shardArray[firstShard + part].list;
+			int begin = (part == 0) ? list.rank(low) : 0;
+			int end = (part == parts - 1) ? list.rank(high) : list.size();
+			copies[part].reserve(end - begin);
+			total += end - begin;
+		}
+		auto copyPart = [&](int part) {
+			shardArray[firstShard + part].list.for_each_in_range(low, high, [&](const Object& found) {
+				copies[part].push_back(found);
+			});
+		};
+		if (parts > 1 && total >= PARALLEL_SCAN) {
+			vector<thread> workers;
+			for (int part = 1; part < parts; part++) {
+				workers.push_back(thread(copyPart, part));
+			}
+			copyPart(0);
+			for (size_t i = 0; i < workers.size(); i++) {
+				workers[i].join();
+			}
+		} else {
+			for (int part = 0; part < parts; part++) {
+				copyPart(part);
+			}
+		}
+
+		result.reserve(total);
+		for (int part = 0; part < parts; part++) {
+			move(copies[part].begin(), copies[part].end(), back_inserter(result));
+		}
+		return result;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method checks the parameter shard for skew and, if it holds at least MIN_SHARD_SIZE Objects
+	and more than SKEW times the average, moves half of the difference between it and its
+	smaller neighbor to that neighbor. The next shard is a neighbor even if no Objects are
+	routed to it yet, which is how the list comes to use more shards as it grows. Only one
+	rebalance runs at a time, and a check is skipped if another rebalance is running.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::checkSkew(int shard) {
+	unique_lock<mutex> running(rebalancing, try_to_lock);
+	if (!running.owns_lock()) {
+		return;
+	}
+	int count = shardArray[shard].count.load(memory_order_relaxed);
+	if (count < MIN_SHARD_SIZE || count <= SKEW * size() / shardCount) {
+		return;
+	}
+
+	int neighbor = -1;
+	if (shard > 0) {
+		neighbor = shard - 1;
+	}
+	if (shard + 1 < shardCount && (neighbor == -1 || shardSize(shard + 1) < shardSize(neighbor))) {
+		neighbor = shard + 1;
+	}
+	if (neighbor == -1) {
+		return;
+	}
+
+	//the routing table only changes while rebalancing is held, so it can be read here
+	SSLRouting* table = new SSLRouting(*routing.load(memory_order_acquire));
+	unique_lock<shared_mutex> lower(shardArray[min(shard, neighbor)].lock);
+	unique_lock<shared_mutex> upper(shardArray[max(shard, neighbor)].lock);
+	int toMove = (shardArray[shard].list.size() - shardArray[neighbor].list.size()) / 2;
+	if (toMove <= 0) {
+		delete table;
+		return;
+	}
+	if (neighbor == shard + 1) {
+		moveUp(shard, toMove, table);
+	} else {
+		moveDown(shard, toMove, table);
+	}
+	publish(table);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves the toMove largest Objects of the parameter shard to the start of the next
+	shard by splitting the shard at the smallest Object being moved and joining the cut off list
+	on to the next shard, and makes that Object the smallest Object routed to the next shard in
+	the parameter table. The caller holds the write locks of both shards.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::moveUp(int shard, int toMove, SSLRouting* table) {
+	SSLShard& from = shardArray[shard];
+	SSLShard& to = shardArray[shard + 1];
+	Object bound = from.list.at(from.list.size() - toMove);
+	to.list.join(from.list.split(bound));
+	from.count.store(from.list.size(), memory_order_relaxed);
+	to.count.store(to.list.size(), memory_order_relaxed);
+	if (shard == (int)table->bounds.size()) {	//the next shard had no range yet
+		table->bounds.push_back(bound);
+	} else {
+		table->bounds[shard] = bound;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves the toMove smallest Objects of the parameter shard, fewer than the shard holds,
+	to the end of the shard before it. The shard is split at the first Object that stays, the
+	part before the cut is joined on to the shard before, and the rest is joined back in to the
+	emptied shard. The Object that stays becomes the smallest Object routed to the shard in the
+	parameter table. The caller holds the write locks of both shards.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::moveDown(int shard, int toMove, SSLRouting* table) {
+	SSLShard& from = shardArray[shard];
+	SSLShard& to = shardArray[shard - 1];
+	Object bound = from.list.at(toMove);
+	SSLList rest = from.list.split(bound);
+	to.list.join(std::move(from.list));
+	from.list.join(std::move(rest));
+	from.count.store(from.list.size(), memory_order_relaxed);
+	to.count.store(to.list.size(), memory_order_relaxed);
+	table->bounds[shard - 1] = bound;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method evens out every shard. Every shard is write locked in order, all of them are joined
+	in to shard 0, and the result is split back out so that each shard holds the same number of
+	Objects, give or take one. With fewer Objects than shards only as many shards as there are
+	Objects are used. Every split and join relinks one pointer per level, so the list is not
+	copied.
+
+	POSTCONDITIONS:
+		- every shard in use holds size() / shards() Objects, give or take one
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::rebalance(void) {
+	lock_guard<mutex> running(rebalancing);
+	vector<unique_lock<shared_mutex> > held;
+	for (int shard = 0; shard < shardCount; shard++) {
+		held.push_back(unique_lock<shared_mutex>(shardArray[shard].lock));
+	}
+
+	SSLList& all = shardArray[0].list;
+	for (int shard = 1; shard < shardCount; shard++) {
+		all.join(std::move(shardArray[shard].list));
+	}
+	int total = all.size();
+	int used = (total < shardCount) ? ((total > 0) ? total : 1) : shardCount;
+
+	vector<Object> cuts;	//smallest Object of each shard after the first, from the top down
+	for (int shard = used - 1; shard > 0; shard--) {	//cuts from the top so the positions below stay put
+		cuts.push_back(all.at((int)((long long)shard * total / used)));
+		shardArray[shard].list.join(all.split(cuts.back()));
+	}
+	SSLRouting* table = new SSLRouting();
+	table->bounds.assign(cuts.rbegin(), cuts.rend());
+	for (int shard = 0; shard < shardCount; shard++) {
+		shardArray[shard].count.store(shardArray[shard].list.size(), memory_order_relaxed);
+		shardArray[shard].sinceCheck = 0;
+	}
+	publish(table);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object from every shard and routes every Object to shard 0 again. Every
+	shard is write locked in order while it runs.
+
+	POSTCONDITIONS:
+		- the list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::makeEmpty(void) {
+	lock_guard<mutex> running(rebalancing);
+	vector<unique_lock<shared_mutex> > held;
+	for (int shard = 0; shard < shardCount; shard++) {
+		held.push_back(unique_lock<shared_mutex>(shardArray[shard].lock));
+	}
+	for (int shard = 0; shard < shardCount; shard++) {
+		shardArray[shard].list.makeEmpty();
+		shardArray[shard].count.store(0, memory_order_relaxed);
+		shardArray[shard].sinceCheck = 0;
+	}
+	publish(new SSLRouting());
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method makes the parameter routing table current with a release store and retires the table
+	it replaces to the reclaimer, so threads still routing with it can finish. The caller holds
+	rebalancing and the write locks of every shard whose range changed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::publish(SSLRouting* table) {
+	SSLRouting* old = routing.exchange(table, memory_order_acq_rel);
+	reclaimer.retire(old, &destroyRouting);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates a routing table once the reclaimer knows no thread can still read it.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+void ShardedSkipList<Object, Compare>::destroyRouting(void* table) {
+	delete static_cast<SSLRouting*>(table);
+};
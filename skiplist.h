@@ -5,18 +5,92 @@
 	Professor:	Rob Nash
 	Class:		CSS342
 
-	This is a templatized class implementing the Skip List data structure. This implementation builds a Skip List with four levels and
-	doubly-linked Nodes. Each level has a dummy head, and dummy tail Node. Each Node contains one object and pointers the Nodes above,
-	below, before, and after it. When a new Node is created it is inserted in to the master level and has a 50% chance of being moved up
-	and inserted in to the next level up. This reduces the average case big o of searching to O(logn). Searching the list starts at the top
-	level where a check is performed to determine if the level is empty. If the level is empty the algorithm moves down to the next level.
-	If the level is not empty each Node's data is compared to the target Object for equality. If a Node is encountered that has contains
-	data greater than the target Object then the search moves back one Node, and down one level. If the bottom level is reached and a
-	matching Node is not found, or if a Node is found at the bottom level that has data greater than the target Object then the Object
-	is not in the list. All memory for Nodes is dynamically created and this class also has built in functionality to remove and deallocate
-	a certain Node from the list, or delete all nodes in the List. 
-
-	NOTE:	Objects are responsible for having overloaded equality operators for comparison. 
+	This is a templatized class implementing the Skip List data structure. This implementation builds a Skip List of tower Nodes whose
+	number of levels grows with the list. Each element of the list is stored in exactly one Node: the Object is stored inline in the Node
+	followed by a variable length array of pointers to the next Node on every level the Node is on, and a pointer to the previous Node on
+	the master level. The list has a single dummy head Node with a pointer for every level, and the end of each level is marked by NULL.
+	When a new Node is created it is promoted to the level above with a chance equal to the promotion probability of the list (50%
+	by default), and its whole height is taken from one word of the Random template parameter (see slrandom.h), so every list has its
+	own generator and the same seed always builds the same list. A Node is never promoted more than one level above the current top
+	level, so the number of levels tracks log base 1/p of n and is capped at MAX_LEVEL. This reduces the average case big o of searching to O(logn). Searching
+	the list starts at the top level of the dummy head. If the Node after the current Node is the end of the level or does not come
+	before the target Object the search moves down one level by reading the next pointer one index lower in the current Node, otherwise
+	it moves right. When the bottom level is reached the Node after the current Node is the only one that can hold the target Object. All memory for Nodes is dynamically created and this class also has built in functionality to
+	remove and deallocate a certain Node from the list, or delete all nodes in the List. Nodes are allocated from the Allocator template
+	parameter, by default a SLPoolAllocator that carves Nodes out of contiguous slabs and recycles deleted Nodes (see slallocator.h).
+
+	When the Indexed template parameter is true every next pointer also stores its width, the number of master level Nodes it skips
+	over. The widths are kept up to date by insert and remove and let rank, at, and erase_at find a position in the list in O(logn)
+	instead of walking the master level.
+
+	The master level can be walked in order with the bidirectional iterators returned by begin and end. lower_bound, upper_bound, and
+	equal_range find the start of a range in O(logn), and for_each_in_range visits every Object in a half-open range without copying,
+	so a range query costs O(logn + k).
+
+	Objects can be moved in to the list with insert(Object&&) or built inside their Node with emplace, so inserting never needs a
+	copy of the Object. The searches used by insert, remove, and the range queries are templates on the type of the target, which
+	lets SkipMap (see skipmap.h) search a list of key/value entries with just a key.
+
+	A list can be built from a sorted range in O(n) with the sorted_tag constructor or assign_sorted, which link each new Node after
+	the last Node of every level it is on in one left to right pass. Copies are built the same way and keep the height of every Node
+	of the list they copy. merge, set_union, set_intersection, and set_difference walk the master levels of two lists in lockstep
+	and build their result in the same single pass, so combining lists of n and m Objects takes O(n + m). merge relinks the Nodes of
+	the other list instead of copying them, and takes over the memory they were allocated from.
+
+	split and join move a whole key range between lists without touching the Nodes in it. split cuts the list at the last Node
+	before a key on every level and hands everything after the cut to a new list, and join links the first Node on each level of
+	a list holding only larger (or only smaller) Objects after the last Node on that level. Both relink one pointer per level, so
+	they run in O(logn). The Nodes keep the memory they were allocated from, which the new list of a split shares with the old one
+	(see slallocator.h). An indexed list works out the size of both sides from the widths at the cut. Other lists mark their size
+	as unknown and size counts the master level once the next time it is called.
+
+	The list keeps a histogram of the top level of its Nodes. level_histogram returns it and skew compares it with the ideal
+	geometric distribution, in which a fraction p^l of the Nodes reach level l. Random heights drift from that shape after long runs
+	of removes, since a remove takes out whatever height the Node had, and searches get longer. rebalance restores the ideal shape
+	in slices: each call rebuilds the towers of at most budget Nodes, giving the Node at position i of the master level the
+	deterministic height of the number of times 1/p divides i (every second Node on level 1, every fourth on level 2, and so on for
+	p = 1/2), and remembers where it stopped, so a full pass can be spread over many calls between other operations.
+
+	The list can also be used as a priority queue. peek_min and pop_min read and unlink the first Node straight from the dummy head,
+	in O(1) and O(height of the Node), and pop_max walks along the end of each level to the Nodes before the last Node without
+	comparing anything. erase_range and erase_until cut a whole run of Nodes out of every level with one relink per level and
+	then deallocate the run in a single walk, so expiring k Objects costs O(logn + k) instead of k searches.
+
+	Lists of trivially copyable Objects can be saved to a snapshot file with save, which streams the master level to disk with
+	the height of every Node (see slsnapshot.h). open_mapped maps a snapshot read-only so it can be searched straight away without
+	reading it, and assign_snapshot bulk loads a mapped snapshot in to a list in O(n), rebuilding the same shape it was saved with.
+
+	contains_batch, insert_batch, and remove_batch process many Objects with one call. They keep a finger, the last Node before the
+	previous Object on every level, and resume each search from the lowest level of the finger that still comes before the next Object
+	instead of from the top of the list. For a sorted batch each search only walks the part of the list between two neighboring Objects
+	of the batch. Unsorted batches are still correct, a search restarts from the dummy head whenever the next Object is not greater than
+	the finger. The Node after the current Node is prefetched while it is compared to hide cache misses.
+
+	Objects are ordered by the Compare template parameter, std::less<Object> by default (see slcompare.h). Every Node a search visits
+	is compared to the target exactly once, and equality is decided once at the end of the search by checking that the target does
+	not come before the Node the search stopped at. A comparator can provide a fixed-width prefix of each Object, which is cached in
+	the Node and compared before the Objects, so most Nodes are passed over without touching the Object.
+
+	enable_filter puts a blocked Bloom filter in front of contains and contains_batch (see slfilter.h), for workloads where most
+	lookups miss. A lookup the filter rejects returns after one cache line of bit probes instead of a search of every level. The
+	filter is sized from size, every Node linked by insert, emplace, or insert_batch is added to it, and it is rebuilt from the
+	master level once it fills up or once half of what was added to it has been removed. Bulk operations rebuild it when they
+	are done, except join and the list returned by split, which leave it unused until the next insert or remove or a call to
+	rebuild_filter so that they stay O(logn).
+
+	Searches and Node allocations are reported to the Stats template parameter (see slstats.h). The default SLNoStats records
+	nothing and compiles away. SLStats records comparisons and steps per level for a sampled fraction of searches, the average
+	search path length next to the expected length, the height histogram, the number and bytes of live Nodes, and the lookups
+	rejected and let through by the filter, its false positive rate, and its size.
+
+	NOTE:	The comparator must be a strict weak ordering. Two Objects are equal when neither comes before the other.
+
+	NOTE:	Memory per element on a 64-bit build with 8-byte keys and a promotion probability of 0.5 (measured with mallinfo over
+			200,000 random inserts):
+				- previous layout, one SLNode per level with up/down/previous/next pointers and a heap copy of the Object per
+				  level: 192 bytes and 4 allocations per element
+				- tower layout, previous pointer, level, inline Object and on average two next pointers: 40 bytes requested,
+				  about 53 bytes including allocator overhead, and 1 allocation per element
 
 ---------------------------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -28,664 +102,2822 @@
 #include <iostream>
 #include <cstdlib>
 #include <stdlib.h>
+#include <new>
+#include <type_traits>
+#include <stdexcept>
+#include <iterator>
+#include <utility>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+#include "slallocator.h"
+#include "slcompare.h"
+#include "slstats.h"
+#include "slfilter.h"
+#include "slrandom.h"
+#include "slsnapshot.h"
 
 using namespace std;
 
-template<class Object>
+//hints the processor to start loading the Node at address in to the cache
+#if defined(__GNUC__) || defined(__clang__)
+#define SL_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define SL_PREFETCH(address) ((void)(address))
+#endif
+
+//tag type passed to the SkipList range constructor to promise that the range is sorted
+struct sorted_tag {};
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+class SkipMap;
+
+template<class Object, class Compare = less<Object>, class Allocator = SLPoolAllocator, bool Indexed = false, class Stats = SLNoStats,
+	class Random = SLXorShift>
 
 class SkipList {
 
 	private:
 
-	struct SLNode {
-		
-		Object* data;		//Object data member
-		SLNode* up;			//Node pointer to the Node above the Node
-		SLNode* down;		//Node pointer to the Node below the Node
-		SLNode* previous;	//Node pointer to the Node before the Node
-		SLNode* next;		//Node pointer to the Node after the Node
-		int level;				//level that the Node is on
-		bool isDummy = false;	//bool value indicating if the Node is a dummy tail or dummy head
-
-		//destructors for the Node. Default no-args constructor initializes all data members to NULL
-		SLNode() : data(NULL), up(NULL), down(NULL), previous(NULL), next(NULL), level(NULL) {};
-		SLNode(const Object& d, SLNode* u, SLNode* dow, SLNode* p, SLNode* n, int l) {
-			data = new Object(d);
-			up = u;
-			down = dow;
-			previous = p;
-			next = n;
-			level = l;
-		
-		};
+	typedef SLCompareTraits<Compare> Traits;
+	typedef typename Traits::prefix_type SLPrefix;	//prefix cached in each Node, empty if Compare has none
+
+	struct SLNode : SLPrefixField<SLPrefix> {
+
+		SLNode* previous;	//Node pointer to the Node before the Node on the master level
+		int level;			//highest level that the Node is on
+		Object data;		//Object data member, stored inline
+		SLNode* next[1];	//Node pointers to the Node after the Node, one per level. Allocated
+							//with level + 1 entries. In an indexed list the pointers are followed
+							//by level + 1 ints holding the width of each pointer
 	};
 
 	public:
 
+	//bidirectional iterator over the master level. Objects in the list can not be changed
+	//through an iterator since that could break the order of the list
+	class const_iterator {
+
+		public:
+
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef Object value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const Object* pointer;
+		typedef const Object& reference;
+
+		const_iterator(void) : node(NULL), list(NULL) {};
+		reference operator*(void) const { return node->data; };
+		pointer operator->(void) const { return &node->data; };
+		const_iterator& operator++(void) { node = node->next[0]; return *this; };
+		const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; };
+		const_iterator& operator--(void) { node = (node == NULL) ? list->lastNode() : node->previous; return *this; };
+		const_iterator operator--(int) { const_iterator old = *this; --*this; return old; };
+		bool operator==(const const_iterator& other) const { return node == other.node; };
+		bool operator!=(const const_iterator& other) const { return node != other.node; };
+
+		private:
+
+		friend class SkipList;
+		const_iterator(const SLNode* n, const SkipList* l) : node(n), list(l) {};
+
+		const SLNode* node;		//Node the iterator is on, NULL past the last Node
+		const SkipList* list;	//list being iterated, used to step back from the end
+	};
+
+	typedef const_iterator iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+	typedef const_reverse_iterator reverse_iterator;
+
 	SkipList(void);										//Default no-args contructor
+	explicit SkipList(double promotion, const Compare& comp = Compare());	//constructor taking the promotion probability
 	~SkipList(void);									//Destructor
 	SkipList(const SkipList& toCopy);					//Copy constructor
+	SkipList(SkipList&& toMove);						//Move constructor, takes over the Nodes of toMove
+	template<class InputIterator>
+	SkipList(InputIterator first, InputIterator last, sorted_tag, double promotion = 0.5,
+		const Compare& comp = Compare());				//builds the list from a sorted range
 	int size(void) const;								//returns size of the list
 	void show(void) const;								//displays the list
 	bool isEmpty(void) const;							//returns bool indicating if there are any Nodes in the lsit
 	bool contains(const Object& target) const;			//returns true if the target object is in the list
 	void operator=(const SkipList& toCopy);				//overloaded assignment operator
+	SkipList& operator=(SkipList&& toMove);				//move assignment, takes over the Nodes of toMove
 	bool operator==(const SkipList& toCompare) const;	//overloaded equality operator
 	bool insert(const Object& toInsert);				//inserts a new Node with the parameter Object
+	bool insert(Object&& toInsert);						//inserts a new Node, moving the parameter Object in to it
+	template<class... Args>
+	bool emplace(Args&&... args);						//inserts a new Node with an Object built from args
 	bool remove(const Object& toRemove);				//removes Node with data equal to the parameter Object
 	void makeEmpty(void);								//deallocates any dynamically allocated memory in the list
+	void seed(uint64_t s);								//restarts the generator that picks Node heights
+	template<class InputIterator>
+	void assign_sorted(InputIterator first, InputIterator last);	//replaces the contents with a sorted range
+	void save(const string& path) const;				//writes the list to a snapshot file
+	static SLMappedSnapshot<Object, Compare> open_mapped(const string& path);	//maps a snapshot file read-only
+	void assign_snapshot(const SLMappedSnapshot<Object, Compare>& snapshot);	//replaces the contents with a snapshot
+	void merge(SkipList&& other);						//moves every Node of other in to the list
+	SkipList split(const Object& key);					//moves every Object not less than key to a new list
+	void join(SkipList&& other);						//moves the Nodes of a list whose range does not overlap in to the list
+	SkipList set_union(const SkipList& other) const;	//returns a list of the Objects in either list
+	SkipList set_intersection(const SkipList& other) const;	//returns a list of the Objects in both lists
+	SkipList set_difference(const SkipList& other) const;	//returns a list of the Objects not in other
+	void enable_filter(const typename SLBloomFilter<Object>::Hasher& hash, double bitsPerObject = 10.0);	//puts a membership filter in front of contains
+	void disable_filter(void);							//drops the membership filter
+	void rebuild_filter(void);							//resizes the membership filter and adds every Object again
+	bool has_filter(void) const;						//returns true if the list has a membership filter
+	vector<int> level_histogram(void) const;			//returns the number of Nodes whose top level is each level
+	double skew(void) const;							//returns how far the heights are from the ideal distribution
+	bool rebalance(int budget = numeric_limits<int>::max());	//gives up to budget more Nodes their ideal height
 	int getCost(void) const;							//returns int value counting number of operations
+	const Stats& getStats(void) const;					//returns the statistics recorded by the list
+	Stats& getStats(void);								//returns the statistics recorded by the list
+	int rank(const Object& target) const;				//returns the number of Objects less than target, indexed lists only
+	const Object& at(int index) const;					//returns the Object at index, indexed lists only
+	bool erase_at(int index);							//removes the Object at index, indexed lists only
+	const Object& peek_min(void) const;					//returns the smallest Object
+	optional<Object> pop_min(void);						//removes and returns the smallest Object
+	optional<Object> pop_max(void);						//removes and returns the largest Object
+	int erase_range(const Object& low, const Object& high);	//removes every Object in [low, high)
+	int erase_until(const Object& key);					//removes every Object less than key
+	const_iterator begin(void) const;					//returns an iterator to the smallest Object
+	const_iterator end(void) const;						//returns an iterator past the largest Object
+	const_reverse_iterator rbegin(void) const;			//returns a reverse iterator to the largest Object
+	const_reverse_iterator rend(void) const;			//returns a reverse iterator before the smallest Object
+	const_iterator lower_bound(const Object& target) const;	//returns an iterator to the first Object not less than target
+	const_iterator upper_bound(const Object& target) const;	//returns an iterator to the first Object greater than target
+	pair<const_iterator, const_iterator> equal_range(const Object& target) const;	//returns the range of Objects equal to target
+	template<class Function>
+	void for_each_in_range(const Object& low, const Object& high, Function visit) const;	//calls visit on each Object in [low, high)
+	template<class InputIterator, class OutputIterator>
+	int contains_batch(InputIterator first, InputIterator last, OutputIterator found) const;	//looks up a batch of Objects
+	template<class InputIterator>
+	int insert_batch(InputIterator first, InputIterator last);	//inserts a batch of Objects
+	template<class InputIterator>
+	int remove_batch(InputIterator first, InputIterator last);	//removes a batch of Objects
 
 	private:
 
-	SLNode* retrieve(const Object& target) const;		//done
+	template<class Key, class Value, class MapCompare, class MapAllocator, class MapStats>
+	friend class SkipMap;
+
+	template<class Target>
+	SLPrefix prefixOf(const Target& target) const;		//returns the prefix of target
+	template<class Target>
+	bool nodeLess(const SLNode* node, const Target& target, const SLPrefix& targetPrefix) const;	//true if node's Object comes before target
+	template<class Target>
+	bool nodeGreater(const SLNode* node, const Target& target, const SLPrefix& targetPrefix) const;	//true if target comes before node's Object
+	template<class Target>
+	bool isMatch(const SLNode* node, const Target& target) const;	//true if a Node not less than target holds it
+	bool nodeBefore(const SLNode* a, const SLNode* b) const;	//true if a's Object comes before b's
+
+	template<class Target>
+	SLNode* retrieve(const Target& target) const;		//done
+	template<class Target>
+	SLNode* findPredecessors(const Target& target, SLNode** update, int* rank = NULL) const;	//records the Node before target on each level
+	SLNode* fingerSearch(const Object& target, SLNode** finger, int* fingerRank) const;	//resumes a search from the last search
+	void resetFinger(SLNode** finger, int* fingerRank) const;	//points a finger at the dummy head
+	void linkNode(SLNode* nodeToInsert, SLNode** update, int* rank);	//sews a Node in after the recorded Nodes
+	SLNode* findIndex(int index, SLNode** update) const;	//records the Node before index on each level
+	template<class Target>
+	SLNode* findGreater(const Target& target) const;	//returns the first Node greater than target
+	SLNode* lastNode(void) const;						//returns the last Node on the master level
+	void findTails(SLNode** tails, int* tailRank) const;	//records the last Node on each level
+	void appendNode(SLNode* node, SLNode** tails, int* tailRank);	//links a Node after the last Node on each level
+	void finishAppend(SLNode** tails, int* tailRank);	//fixes the widths of the last Node on each level
+	template<class InputIterator>
+	void appendSorted(InputIterator first, InputIterator last);	//adds a sorted range to the end of the list
+	void unlinkNode(SLNode* toDelete, SLNode** update);		//unlinks and deletes a Node
+	int cutSpan(SLNode** before, int* beforeRank, SLNode** last, int* lastRank);	//unlinks and deletes a run of Nodes
+	void detachNodes(void);								//empties the list without deleting its Nodes
+	void appendList(SkipList& other);					//links the Nodes of a list of larger Objects after the last Nodes
+	void prependList(SkipList& other);					//links the Nodes of a list of smaller Objects before the first Nodes
+	void handOverStats(const SLNode* first, SkipList& to);	//moves the statistics of a run of Nodes to another list
+	void filterAdd(const Object& added);				//adds an Object to the membership filter
+	void filterErase(int removed = 1);					//tells the membership filter Objects were removed
+	void countHeights(void) const;						//rebuilds the height histogram from the master level
+	int idealLevel(int position) const;					//returns the deterministic level of the Node at position
+	SLNode* retowerNode(SLNode* node, int l, SLNode** update, int* rank);	//replaces a Node with one on level l
+	SkipList combine(const SkipList& other, bool keepOnlyThis, bool keepBoth, bool keepOnlyOther) const;	//walks both lists in lockstep
+	static int* widths(SLNode* node);					//returns the widths of an indexed Node's pointers
 	void initialize(void);								//dome
-	bool moveUp(void) const;							//done
+	int randomLevel(void) const;						//picks the highest level for a new Node
+	SLNode* createNode(const Object& d, int l);			//allocates a Node and copies the Object in to it
+	template<class... Args>
+	SLNode* emplaceNode(int l, Args&&... args);			//allocates a Node and builds the Object in it from args
 	void deleteNode(SLNode*& toClear);					//done
 	void clear(void);									//done
 	bool levelIsEmpty(const int currentLevel) const;	//done
-	int cost;
-
-	static const int LEVEL = 4;			//final number of levels
-	SLNode* dummyHead[LEVEL];			//dynamic array for nodes
+	void addLevel(void);								//adds a new empty level to the top of the list
+	void trimLevels(void);								//removes empty levels from the top of the list
+	static size_t nodeSize(int l);						//returns the number of bytes in a Node on level l
+	mutable Stats stats;				//records searches and Node allocations, see slstats.h
+
+	Compare compare;					//orders the Objects in the list
+	Allocator allocator;				//allocator that all Nodes other than the dummy head come from
+	mutable Random random;				//picks the height of new Nodes, see slrandom.h
+	SLBloomFilter<Object> filter;		//optional membership filter checked by contains, see slfilter.h
+
+	static const int MAX_LEVEL = 32;	//hard ceiling on the number of levels
+	double probability;					//chance of a Node being promoted to the next level
+	int levels;							//number of levels currently in the list
+	mutable int count;					//number of Nodes in the master level
+	mutable bool countStale;			//true if count is out of date after a split or join, size recounts
+	mutable int heights[MAX_LEVEL];		//number of Nodes whose top level is each level
+	mutable bool heightsStale;			//true if heights is out of date after a split, recounted when needed
+	SLNode* rebalanceAt;				//Node the next rebalance slice starts at, NULL at the end of a pass
+	bool rebalancing;					//true while a rebalance pass is under way
+	int rebalancePosition;				//position of the last Node the previous rebalance slice handled
+	SLNode* dummyHead;					//dummy head Node with a next pointer for every level
 };
 
 #endif // !skiplist_h
 
 
 /*-------------------------------------------------------------------------------------------------
-	
-	Method retuns an int value equal to the number of operations it has taken to insert
-	and retrieve from the list. Method cannot change any data members.
+
+	Method retuns an int value equal to the number of comparisons between Objects it has taken
+	to insert, remove, and retrieve from the list, as recorded by the statistics policy. With
+	SLNoStats nothing is recorded and the method returns 0, and with SLStats only sampled
+	searches are counted. Method cannot change any data members.
 
 	POSTCONDTIONS:
-		- returns cost
+		- returns the number of comparisons recorded by the statistics policy
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-int SkipList<Object>::getCost(void) const {
-	return cost;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::getCost(void) const {
+	return (int)stats.comparisons();
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Copy-constructor. Uses the overloaded assignment operator to make a deep-copy of the SkipList.
+	Method returns the statistics policy of the list, which holds everything recorded about
+	its searches and Nodes (see slstats.h). The non-const overload lets the sample rate be
+	changed and the search statistics be reset.
 
-	NOTES:	Uses the overloaded assignment operator
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+const Stats& SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::getStats(void) const {
+	return stats;
+};
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+Stats& SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::getStats(void) {
+	return stats;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method puts a blocked Bloom filter in front of contains and contains_batch (see slfilter.h).
+	Each Object is hashed by the parameter hasher, which must give equal hashes to Objects that
+	are equal under the comparator, and the filter takes the parameter number of bits per Object
+	at its capacity: 10 bits gives a false positive rate of about 1%. The filter is built from
+	the Objects in the list right away, in O(n). Replaces any filter the list already had.
+
+	POSTCONDITIONS:
+		- lookups of Objects that are not in the list mostly return without a search
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-SkipList<Object>::SkipList(const SkipList& toCopy) {
-	*this = toCopy;	//uses overloaded assignment operator to copy list
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::enable_filter(const typename SLBloomFilter<Object>::Hasher& hash,
+	double bitsPerObject) {
+	filter.enable(hash, bitsPerObject);
+	rebuild_filter();
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method prints the contents of the Skip List to the console. Levels of the Skip List and the
-	dummy nodes are indicated by "+inf" and "-inf". Method cannot change any data members.
+	Method drops the membership filter and its memory. Every lookup searches the list again.
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-void SkipList<Object>::show(void) const {
-	cout << "contents:" << endl;		//prints header for the Skip List
-	for (SLNode* col = dummyHead[0]; col != NULL; col = col->next) {	//iterates over each level in the list
-		SLNode* row = col;
-		for (int level = 0; row != NULL && level < LEVEL; level++) {	//iterates over each Node in the level
-			if (row->previous == NULL) { 
-				cout << "-inf\t";		//prints the dummy header
-			}
-			else if (row->next == NULL) {
-				cout << "+inf\t";		//prints the dummy tail
-			}
-			else {
-				cout << *row->data << "\t";	//prints the data of the Node
-			}
-			row = row->up;					//moves to the next level of the list
-		}
-		cout << endl;
-	}
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::disable_filter(void) {
+	filter.disable();
+	stats.filterResized(0);
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Constructor. Instantiates a SkipList object and calls initialize to create the dummy
-	head and dummy tail nodes.
+	Method sizes the membership filter for twice the number of Objects in the list, clears it,
+	and walks the master level once to add every Object. Called by the list whenever the filter
+	fills up or has had half of its Objects removed, and after bulk operations. Can be called
+	after split or join so that lookups use the filter again before the next insert or remove.
+	Does nothing if the list has no filter.
 
 	POSTCONDITIONS:
-		- instantiates new SkipList Object
-		- initializes dummy head and dummy tail nodes
+		- the filter covers every Object in the list
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-SkipList<Object>::SkipList(void) {
-	initialize();					//initializes dummy nodes for each level
-	cost = 0;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::rebuild_filter(void) {
+	if (!filter.enabled()) {
+		return;
+	}
+	filter.reset(size());
+	for (SLNode* current = dummyHead->next[0]; current != NULL; current = current->next[0]) {
+		filter.add(current->data);
+	}
+	stats.filterResized(filter.bytes());
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Destructor. Calls makeEmpty to deallocate all memory allocated for Nodes that have
-	been inserted in to the list. Deletes all dummy head and dummy tail nodes.
+	Method returns true if the list has a membership filter, whether or not it is up to date.
+	Method cannot change any data members.
 
-	POSTCONDITIONS:
-		- deallocates all dynamically allocated memory
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::has_filter(void) const {
+	return filter.enabled();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds the parameter Object, which was just linked in to the list, to the membership
+	filter, and rebuilds the filter if it is now past its capacity or was stale. Does nothing if
+	the list has no filter.
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-SkipList<Object>::~SkipList(void) {
-	makeEmpty();	//calls makeEmpty
-	//iterates over the levels in the list deleting
-	//all dummy head and dummy tail nodes
-	for (int i = 0; i < LEVEL; i++) {
-		delete dummyHead[i]->next->data;
-		delete dummyHead[i]->next;
-		delete dummyHead[i]->data;
-		delete dummyHead[i];
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::filterAdd(const Object& added) {
+	if (!filter.enabled()) {
+		return;
+	}
+	if (filter.active()) {
+		filter.add(added);
+	}
+	if (filter.needsRebuild()) {
+		rebuild_filter();
 	}
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method takes in an Object and inserts it in to the list. A new node is created to contain
-	the object. If the Object is already in the list the method returns false. This method calls
-	contains, retrieve, and moveUp as helper functions.
-
-	POSTCONDITIONS:
-		- inserts a new Node in to the list
+	Method counts the parameter number of Objects that were just unlinked from the list against
+	the membership filter, and rebuilds the filter once half of the Objects added to it have
+	been removed or if it was stale. Does nothing if the list has no filter.
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-bool SkipList<Object>::insert(const Object& toInsert) {
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::filterErase(int removed) {
+	if (!filter.enabled()) {
+		return;
+	}
+	filter.erase(removed);
+	if (filter.needsRebuild()) {
+		rebuild_filter();
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
 
-	int currentLevel = 0;
-	SLNode* nodeToInsert;
-	SLNode* nodeBefore;
-	SLNode* nodeAfter;
-	bool success = false;
+	Copy-constructor. Uses the overloaded assignment operator to make a deep-copy of the SkipList
+	in O(n). The copy uses the same promotion probability and comparator as the parameter list.
 
-	//checks if the list is empty. If so inserts the Node in the master level between the two
-	//dummy Nodes. Connects the dummy nodes to the new node
-	if (isEmpty()) {
-		
-		nodeBefore = dummyHead[currentLevel];
-		nodeAfter = dummyHead[currentLevel]->next;
-		nodeToInsert = new SLNode(toInsert, NULL, NULL, nodeBefore, nodeAfter, currentLevel);
-		
-		nodeBefore->next = nodeToInsert;
-		nodeAfter->previous = nodeToInsert;
-		//sets success to true
-		success = true;
-	} else {	//otherwise we know that there are nodes in the list
+	NOTES:	Uses the overloaded assignment operator
 
-		bool isInList = contains(toInsert);		//checks if the Object is already in the list
+-------------------------------------------------------------------------------------------------*/
 
-		if (!isInList) {
-			nodeAfter = retrieve(toInsert);		//returns a pointer to the SLNode we want to insert our new SLNode before
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SkipList(const SkipList& toCopy) : compare(toCopy.compare), random(toCopy.random) {
+	probability = toCopy.probability;
+	initialize();		//initializes the dummy head
+	*this = toCopy;	//uses overloaded assignment operator to copy list
+};
 
-			while (nodeAfter->level > 0) {				//while loop cycles through SLNodes until we are at the master level
-				nodeAfter = nodeAfter->down;
-			}
+/*-------------------------------------------------------------------------------------------------
 
-			nodeBefore = nodeAfter->previous;	//SLNode* to the node right before where we want to insert
+	Move constructor. Takes over the dummy head, Nodes, allocator memory, and membership filter
+	of the parameter list in O(1). The parameter list is left empty with a new dummy head and no
+	filter.
 
-			//creates new SLNode and connects it to the nodeBefore and nodeAfter
-			nodeToInsert = new SLNode(toInsert, NULL, NULL, nodeBefore, nodeAfter, currentLevel++);
+-------------------------------------------------------------------------------------------------*/
 
-			nodeAfter->previous = nodeToInsert;			//connects previous node to new node
-			nodeBefore->next = nodeToInsert;			//connects nodeAfter to newly inserted node
-			success = true;
-		} else {
-			return false;
-		}
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SkipList(SkipList&& toMove)
+	: stats(toMove.stats), compare(toMove.compare), random(toMove.random), filter(std::move(toMove.filter)) {
+	allocator.absorb(toMove.allocator);
+	probability = toMove.probability;
+	dummyHead = toMove.dummyHead;
+	levels = toMove.levels;
+	count = toMove.count;
+	countStale = toMove.countStale;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		heights[currentLevel] = toMove.heights[currentLevel];
 	}
-	//calls moveUp() to determine if the Node should be inserted in the
-	//the next level up
-	bool moveOneUp = moveUp();
-	SLNode* moveNodeUp;
-	SLNode* nodeBelow = nodeToInsert;
-
-	//continues to insert the Node in to the next level up while moveOneUp
-	//is true. moveUp() is called at the end of each loop to determine if the
-	//Node should be moved up again
-	while (moveOneUp) {
-
-		nodeBefore = nodeToInsert->previous;
-		nodeAfter = nodeToInsert->next;
-
-		moveNodeUp = new SLNode(toInsert, NULL, nodeBelow, NULL, NULL, currentLevel + 1);
-
-		currentLevel++;
-		//finds the nodefore the node in the next level up
-		//so that pointers can be reset and the new Node sewn in
-		while (nodeBefore->up == NULL && nodeBefore->level < LEVEL) {
-			nodeBefore = nodeBefore->previous;
-		}
-		nodeBefore = nodeBefore->up;
-		//finds the nodeAfter the node in the next level up
-		//so that pointers can be reset and the new Node sewn in
-		while (nodeAfter->up == NULL && nodeAfter->level < LEVEL) {
-			nodeAfter = nodeAfter->next;
-		}
-		nodeAfter = nodeAfter->up;
-		//sews the new Node into the current level
-		nodeBelow->up = moveNodeUp;
-		nodeBelow = nodeBelow->up;
-		nodeBefore->next = moveNodeUp;
-		moveNodeUp->previous = nodeBefore;
-		nodeAfter->previous = moveNodeUp;
-		moveNodeUp->next = nodeAfter;
-		//bnreaks if we have reached the top level
-		if (currentLevel >= LEVEL) {
-			break;
-		}
-		//resets moveOneUp
-		moveOneUp = moveUp();
+	heightsStale = toMove.heightsStale;
+	rebalanceAt = toMove.rebalanceAt;
+	rebalancing = toMove.rebalancing;
+	rebalancePosition = toMove.rebalancePosition;
+	toMove.stats = Stats();
+	toMove.filter = SLBloomFilter<Object>();
+	toMove.initialize();		//gives the parameter list a new, empty dummy head
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Move assignment operator. Deallocates the Nodes of this list, then takes over the dummy head,
+	Nodes, allocator memory, and membership filter of the parameter list in O(1) the way the
+	move constructor does, along with its comparator and promotion probability. The parameter
+	list is left empty with a new dummy head and no filter.
+
+	POSTCONDITIONS:
+		- the list holds the Nodes the parameter list held
+		- the parameter list is empty
+
+-------------------------------------------------------------------------------------------------*/
 
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>& SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::operator=(SkipList&& toMove) {
+	if (this == &toMove) {	//bails if the parameter list is this list
+		return *this;
+	}
+	makeEmpty();						//deallocates all memory in the list
+	::operator delete(dummyHead);
+	allocator.absorb(toMove.allocator);
+	stats = toMove.stats;
+	compare = toMove.compare;
+	random = toMove.random;
+	filter = std::move(toMove.filter);
+	probability = toMove.probability;
+	dummyHead = toMove.dummyHead;
+	levels = toMove.levels;
+	count = toMove.count;
+	countStale = toMove.countStale;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		heights[currentLevel] = toMove.heights[currentLevel];
 	}
-	return success;
+	heightsStale = toMove.heightsStale;
+	rebalanceAt = toMove.rebalanceAt;
+	rebalancing = toMove.rebalancing;
+	rebalancePosition = toMove.rebalancePosition;
+	toMove.stats = Stats();
+	toMove.filter = SLBloomFilter<Object>();
+	toMove.initialize();		//gives the parameter list a new, empty dummy head
+	return *this;
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method returns a bool indicating if the Node should be moved up a level. Value is determined
-	by a random number generator. Returns true if the number generated is greater than 50.
-	Method cannot change any data members.
+	Constructor. Builds a SkipList from the range [first, last), which must be sorted in
+	ascending order of the parameter comparator, with the parameter promotion probability. Each Object is compared only to
+	the Object before it and linked after the last Node on every level, so the list is built
+	in one O(n) pass. Duplicates are skipped, and an Object that is out of order is inserted
+	with a normal search instead.
 
 	POSTCONDITIONS:
-		- returns bool indicating if the Node should be moved up a level
+		- instantiates a SkipList Object holding every distinct Object in the range
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-bool SkipList<Object>::moveUp(void) const {
-	int moveUp = rand() % 100;	//generates random numebr
-	return moveUp > 50;			//returns if moveUp is greater than 50
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class InputIterator>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SkipList(InputIterator first, InputIterator last, sorted_tag, double promotion,
+	const Compare& comp) : compare(comp) {
+	if (promotion <= 0.0 || promotion >= 1.0) {	//rejects probabilities that would
+		promotion = 0.5;						//never or always promote
+	}
+	probability = promotion;
+	initialize();					//initializes the dummy head
+	appendSorted(first, last);
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method returns a SLNode* to the Node that contains a data Object that matches the target
-	parameter. If the target parameter is not found in the list then the Node* to the Node
-	that contains a Object data member one greater than the target parameter is returned.
-	Method cannot change any data members.
+	Method prints the contents of the Skip List to the console. Each row is one Node, printed
+	once for every level it is on. The dummy head and the end of each level are indicated by
+	"-inf" and "+inf". Method cannot change any data members.
 
-	POSTCONDITIONS:
-		- returns a Node* to the Node that contains the target parameter
-		- returns a Node* to the Node greater than the target parameter
-
--------------------------------------------------------------------------------------------------*/
-
-template<class Object>
-typename SkipList<Object>::SLNode* SkipList<Object>::retrieve(const Object& target) const  {
-	//checks if the list is empty, if so returns the
-	//dummy tail node on the bottom master level
-	if (isEmpty()) {
-		return dummyHead[0]->next;
-	} else {								
-		SLNode* current;	//SLNode* to walk the list
-
-		//loop iterates over the list starting at the top level and working its
-		//way down. If a SLNode is encountered that contains a data member greater
-		//than the target current is moved one back and one down. If the bottom
-		//level is reached and current encounters a data member greater than target
-		//that SLNode* is returned.
-		for (int currentLevel = LEVEL - 1; currentLevel > -1; currentLevel--) {
-			current = dummyHead[currentLevel];
-
-			if (levelIsEmpty(currentLevel) && currentLevel != 0) {	//checks if the level is empty
-				current = current->down;							//if so move the Node down one
-			}  else {
-				current = current->next;
-				while (current->isDummy == false) {	//iterates over the current level comparing
-					if (*current->data == target) {	//current to target
-						return current;
-					} else if (*current->data > target) {
-						if (current->level == 0) {
-							return current;
-						} else {
-							current = current->previous->down;
-						}
-					}
-					current = current->next;
-				}
-			}
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::show(void) const {
+	cout << "contents:" << endl;		//prints header for the Skip List
+	for (int level = 0; level < levels; level++) {
+		cout << "-inf\t";				//prints the dummy head
+	}
+	cout << endl;
+	for (SLNode* row = dummyHead->next[0]; row != NULL; row = row->next[0]) {	//iterates over each Node
+		for (int level = 0; level <= row->level; level++) {						//iterates over each level of the Node
+			cout << row->data << "\t";	//prints the data of the Node
 		}
-		return current;
+		cout << endl;
 	}
-}
+	for (int level = 0; level < levels; level++) {
+		cout << "+inf\t";				//prints the end of each level
+	}
+	cout << endl;
+};
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method returns a bool value indicating if the target Object is in the SkipList. retrieve() is
-	called as a helper method and the data of the Node returned is evaluated for equality with
-	the target parameter. Method cannot change any data members.
+	Constructor. Instantiates a SkipList object and calls initialize to create the dummy
+	head node. Nodes are promoted with a probability of 0.5.
 
 	POSTCONDITIONS:
-		- returns a bool value indicating if the target is in the SkipList
+		- instantiates new SkipList Object
+		- initializes the dummy head node
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-bool SkipList<Object>::contains(const Object& target) const  {
-	SLNode* temp = retrieve(target);	//attempts to retrieve the target parameter
-	if (temp->data == NULL) {			//returns if the target parameter's data is
-		return false;					//NULL indicating a dummy Node
-	}
-	if (target == *temp->data) {		//returns if the Node's data is equal
-		return true;					//to the target
-	}
-	return false;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SkipList(void) {
+	probability = 0.5;
+	initialize();					//initializes the dummy head
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method returns an int value corresponding to the number of nodes in the master level.
-	Method cannot change any data members.
+	Constructor. Instantiates a SkipList object whose Nodes are promoted to the next level with
+	the parameter probability. Values outside of (0, 1) fall back to 0.5. Smaller values build
+	taller, sparser lists with fewer pointers per Node; larger values build shorter lists with
+	fewer comparisons per level. Objects are ordered with the parameter comparator.
 
 	POSTCONDITIONS:
-		- returns an int value corresponding to the number of Nodes in the master level
+		- instantiates new SkipList Object
+		- initializes the dummy head node
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-int SkipList<Object>::size(void) const {
-	int retVal = 0;		//variable to hold the number of unique nodes in the list
-	if (isEmpty()) {	//checks if the list is empty
-		return retVal;	//returns a size of zero
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SkipList(double promotion, const Compare& comp) : compare(comp) {
+	if (promotion <= 0.0 || promotion >= 1.0) {	//rejects probabilities that would
+		promotion = 0.5;						//never or always promote
 	}
-	SLNode* current = dummyHead[0];	//node to walk the list
+	probability = promotion;
+	initialize();					//initializes the dummy head
+};
 
-	while (current->next->data != NULL) {	//increases retVal
-		current = current->next;			//for each node in the master level
-		retVal++;
-	}
-	return retVal;	//returns retVal
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. Calls makeEmpty to deallocate all memory allocated for Nodes that have
+	been inserted in to the list. Deletes the dummy head node.
+
+	POSTCONDITIONS:
+		- deallocates all dynamically allocated memory
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::~SkipList(void) {
+	makeEmpty();						//calls makeEmpty
+	::operator delete(dummyHead);		//the dummy head never had an Object constructed in it
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method returns a bool value indicating if there are any Nodes in the master level.
-	Method cannot change any data members.
+	Method takes in an Object and inserts it in to the list. A new node is created to contain
+	the object. If the Object is already in the list the method returns false. The list is
+	searched once from the top level down by findPredecessors, which records the last Node
+	before the Object on every level. The new Node is then sewn in after the recorded Node on
+	each level it is on. This method calls findPredecessors, randomLevel, and createNode as
+	helper functions.
 
 	POSTCONDITIONS:
-		- returns false if there are no Nodes in the master level
+		- inserts a new Node in to the list
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-bool SkipList<Object>::isEmpty(void) const {
-	SLNode* current = dummyHead[0];	//Node to walk the list
-	return current->next->data == NULL;	//returns if the next node in the list is the dummy tail
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::insert(const Object& toInsert) {
+
+	SLNode* update[MAX_LEVEL];	//last Node before toInsert on each level
+	int rank[MAX_LEVEL];		//position of each Node in update, indexed lists only
+	SLNode* nodeAfter = findPredecessors(toInsert, update, rank);
+
+	if (isMatch(nodeAfter, toInsert)) {	//checks if the Object is already in the list
+		return false;
+	}
+
+	linkNode(createNode(toInsert, randomLevel()), update, rank);
+	return true;
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method deallocates all dynamically allocated memory for Nodes other than the dummy head
-	and dummy tail nodes. Calls clear as a helper function
+	Method takes in an Object and inserts it in to the list the same way as insert, except that
+	the Object is moved in to the new Node instead of copied. If the Object is already in the
+	list the method returns false and the parameter is left unchanged.
 
 	POSTCONDITIONS:
-		- deletes all non-dummy nodes in the list
+		- inserts a new Node in to the list
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-void SkipList<Object>::makeEmpty(void) {
-	if (isEmpty()) {	//bails if the list is already empty
-		return;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::insert(Object&& toInsert) {
+
+	SLNode* update[MAX_LEVEL];	//last Node before toInsert on each level
+	int rank[MAX_LEVEL];		//position of each Node in update, indexed lists only
+	SLNode* nodeAfter = findPredecessors(toInsert, update, rank);
+
+	if (isMatch(nodeAfter, toInsert)) {	//checks if the Object is already in the list
+		return false;
 	}
-	clear();			//calls clear
+
+	linkNode(emplaceNode(randomLevel(), std::move(toInsert)), update, rank);
+	return true;
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method deallocates all dynamically allocated memory for Nodes other than the dummy head
-	and dummy tail nodes. Calls toDelete as a helper function.
+	Method builds an Object from the parameter arguments directly inside a new Node and inserts
+	the Node in to the list. The Object has to exist before the list can be searched for it, so
+	if it is already in the list the new Node is deleted and the method returns false.
 
 	POSTCONDITIONS:
-		- deletes all non-dummy nodes in the list
+		- inserts a new Node in to the list
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-void SkipList<Object>::clear(void) {
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class... Args>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::emplace(Args&&... args) {
+	SLNode* newNode = emplaceNode(randomLevel(), std::forward<Args>(args)...);
 
-	SLNode* current;		//SLNode to keep track of the current node
-	SLNode* toDelete;
+	SLNode* update[MAX_LEVEL];	//last Node before the new Object on each level
+	int rank[MAX_LEVEL];		//position of each Node in update, indexed lists only
+	SLNode* nodeAfter = findPredecessors(newNode->data, update, rank);
 
-	//for loop that iterates over each level in the skip list and 
-	//deletes nodes starting at the top (most sparsely populated level)
-	//and works it's way down
-	for (int currentLevel = LEVEL - 1; currentLevel > -1; currentLevel--) {
-		current = dummyHead[currentLevel];
-		if (levelIsEmpty(currentLevel)) {
-			current = current->down;
-		} else {
+	if (isMatch(nodeAfter, newNode->data)) {	//checks if the Object is already in the list
+		deleteNode(newNode);
+		return false;
+	}
+
+	linkNode(newNode, update, rank);
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method sews the parameter Node in to the list after the Node recorded in update on every
+	level it is on. If the Node is taller than the list a level is added and update is extended
+	with the dummy head. In an indexed list rank must hold the positions of the recorded Nodes.
+
+	POSTCONDITIONS:
+		- nodeToInsert is in the list
+
+-------------------------------------------------------------------------------------------------*/
 
-			current = current->next;	//sets current equal to the first initialized node in the level
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::linkNode(SLNode* nodeToInsert, SLNode** update, int* rank) {
+	int nodeLevel = nodeToInsert->level;
+	if (nodeLevel == levels) {		//a Node may only grow the list by one level at a time
+		update[levels] = dummyHead;
+		rank[levels] = 0;
+		addLevel();
+	}
 
-			//while loop that continues until the dummy tail (identified by data == NULL)
-			//is reached. deletes each node on the current level
+	//sews the new Node in after the recorded Node on every level it is on
+	for (int currentLevel = 0; currentLevel <= nodeLevel; currentLevel++) {
+		nodeToInsert->next[currentLevel] = update[currentLevel]->next[currentLevel];
+		update[currentLevel]->next[currentLevel] = nodeToInsert;
+	}
 
-			while (current->isDummy == false) {	//deletes each node in the level until the
-				toDelete = current;				//dummy tail is reached
-				current = current->next;
-				deleteNode(toDelete);
+	//splits the width of each pointer the new Node was sewn in to, and
+	//widens the pointers that pass over the new Node on the levels above it
+	if (Indexed) {
+		int position = rank[0] + 1;		//position of the new Node
+		for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+			int* before = widths(update[currentLevel]);
+			if (currentLevel <= nodeLevel) {
+				widths(nodeToInsert)[currentLevel] = before[currentLevel] - (position - rank[currentLevel]) + 1;
+				before[currentLevel] = position - rank[currentLevel];
+			} else {
+				before[currentLevel]++;
 			}
 		}
 	}
+	count++;
+	heights[nodeLevel]++;
+
+	//connects the previous pointers on the master level
+	nodeToInsert->previous = (update[0] == dummyHead) ? NULL : update[0];
+	if (nodeToInsert->next[0] != NULL) {
+		nodeToInsert->next[0]->previous = nodeToInsert;
+	}
+	filterAdd(nodeToInsert->data);
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method returns a bool value indicating if the level of the list is empty, has no nodes
-	other than the dummy head and dummy tail nodes. Method cannot change any data members.
+	Method returns the highest level a new Node will be on. The level is taken from one word of
+	the generator, a count of trailing zero bits for a promotion probability of 1/2 or 1/4, so
+	the Node is on level k or above with a chance of probability^k. The Node is never put more
+	than one level above the current top level or past MAX_LEVEL. Method cannot change any data
+	members other than the state of the generator.
+
+	POSTCONDITIONS:
+		- returns a level between 0 and levels, inclusive
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-bool SkipList<Object>::levelIsEmpty(const int currentLevel) const {
-	//returns true if the dummy head's data member equals the next node (both are NULL)
-	if (dummyHead[currentLevel]->isDummy == true && dummyHead[currentLevel]->next->isDummy == true) {
-		return true;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::randomLevel(void) const {
+	int nodeLevel = slLevelFromWord(random(), probability);
+	if (nodeLevel > levels) {
+		nodeLevel = levels;
 	}
-	return false;
+	if (nodeLevel > MAX_LEVEL - 1) {
+		nodeLevel = MAX_LEVEL - 1;
+	}
+	return nodeLevel;
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method deallocates all memory for the Node passed through as a parameter. The Nodes before,
-	after, below, and above the Node to be deleted will be redirected to correctly be sewn into
-	the list.
+	Method restarts the generator that picks the height of new Nodes from the parameter seed.
+	Two lists seeded the same way that see the same inserts have the same shape. Every list
+	starts from the default seed of its generator.
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-void SkipList<Object>::deleteNode(SLNode*& toClear) {
-	if (toClear == NULL) {	//checks if toClear is NULL
-		return;				//bails
-	}
-	//Node pointers set to each of the Node's
-	//surrounding the Node to be deleted
-	//int variable equal to the level toClear is on
-	SLNode* nodeBefore = toClear->previous;
-	SLNode* nodeAfter = toClear->next;
-	SLNode* nodeUp = toClear->up;
-	SLNode* nodeDown = toClear->down;
-	int level = toClear->level;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::seed(uint64_t s) {
+	random.seed(s);
+};
+
+/*-------------------------------------------------------------------------------------------------
 
-	//deletes toClear's data
-	//also deletes toClear
-	delete toClear->data;
-	delete toClear;
-	toClear = NULL;	//sets toClear to NULL
+	Method returns the prefix of the target parameter if the comparator provides one, otherwise
+	an empty SLNoPrefix. A search computes the prefix of its target once before it starts.
 
-	//sews in the Nodes surrounding the delted Node
-	nodeBefore->next = nodeAfter;
-	nodeAfter->previous = nodeBefore;
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLPrefix SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::prefixOf(const Target& target) const {
+	return Traits::prefix(compare, target);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the Object in the parameter Node comes before the target. If the
+	comparator provides a prefix the cached prefix of the Node is compared to the prefix of the
+	target first, and the Objects themselves are only compared when the prefixes are equal. Each
+	call is reported to the statistics policy as one comparison.
+
+-------------------------------------------------------------------------------------------------*/
 
-	if (nodeDown != NULL) {
-		nodeDown->up = nodeUp;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::nodeLess(const SLNode* node, const Target& target, const SLPrefix& targetPrefix) const {
+	stats.compared();
+	if constexpr (Traits::hasPrefix) {
+		if (node->prefix != targetPrefix) {
+			return node->prefix < targetPrefix;
+		}
 	}
-	if (nodeUp != NULL) {
-		nodeUp->down = nodeDown;
+	return compare(node->data, target);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target comes before the Object in the parameter Node, checking
+	the prefixes first the same way as nodeLess. Each call is reported as one comparison.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::nodeGreater(const SLNode* node, const Target& target, const SLPrefix& targetPrefix) const {
+	stats.compared();
+	if constexpr (Traits::hasPrefix) {
+		if (node->prefix != targetPrefix) {
+			return targetPrefix < node->prefix;
+		}
 	}
+	return compare(target, node->data);
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Takes in an object and calls contain and retrieve to find if the object is in the SkipList.
-	If the object is in the SkipList it is removed via deleteNode. A bool value is returned
-	indicating whether the Node was successfully removed from the list.
+	Method returns true if the parameter Node holds an Object equal to the target. The Node must
+	be the result of a search for the target, the first Node that does not come before it, so
+	only one comparison is needed to rule out that the target comes before the Node.
 
 	POSTCONDITIONS:
-		- removes the node containing the data member equal to the target parameter from the
-		  list
-		- returns a bool value indicating success
+		- returns false if node is NULL
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-bool SkipList<Object>::remove(const Object& toRemove) {
-	
-	bool canRemove = contains(toRemove);	//checks to see if the object is in the list
-	SLNode* current;
-	SLNode* toDelete;						//will hold SLNode* to the node containing toRemove
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::isMatch(const SLNode* node, const Target& target) const {
+	return node != NULL && !nodeGreater(node, target, prefixOf(target));
+};
 
-	if (canRemove) {	//if the object is in the list
-		current = retrieve(toRemove);		//sets deleteNode to the node containing toRemove
-		for (int currentLevel = current->level; currentLevel > -1; currentLevel--) {
-			toDelete = current;
-			current = current->down;
-			deleteNode(toDelete);				//deletes the appropriate node and resets pointers
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the Object in Node a comes before the Object in Node b, comparing
+	their cached prefixes first if the comparator provides them. The Nodes may belong to
+	different lists. Each call is reported as one comparison.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::nodeBefore(const SLNode* a, const SLNode* b) const {
+	stats.compared();
+	if constexpr (Traits::hasPrefix) {
+		if (a->prefix != b->prefix) {
+			return a->prefix < b->prefix;
 		}
-		return true;
-	} else {
-		cout << "Object not in SkipList!" << endl;
 	}
-	
-	return false;							//returns false if the object was not in the list
+	return compare(a->data, b->data);
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Method initializes dummy head and dummy tail nodes. Dummy nodes have data objects
-	initialized to NULL.
+	Method returns a SLNode* to the Node that contains a data Object that matches the target
+	parameter. If the target parameter is not found in the list then the Node* to the first Node
+	on the master level that contains a Object data member greater than the target parameter is
+	returned, or NULL if there is no such Node. Each Node visited is compared to the target once,
+	and equality is left to the caller. Method cannot change any data members.
 
 	POSTCONDITIONS:
-		- initializes dummy head and dummy tail nodes
+		- returns a Node* to the Node that contains the target parameter
+		- returns a Node* to the Node greater than the target parameter, or NULL
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-void SkipList<Object>::initialize(void) {
-
-	for (int currentLevel = 0; currentLevel < LEVEL; currentLevel++) {
-		
-		dummyHead[currentLevel] = new SLNode;		//creates empty SLNode
-		dummyHead[currentLevel]->isDummy = true;
-		dummyHead[currentLevel]->level = currentLevel;
-		
-		if (currentLevel > 0) {						//if the current level is not the master level
-			//sets the down pointer to the dummy node below
-			dummyHead[currentLevel]->down = dummyHead[currentLevel - 1];
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::retrieve(const Target& target) const  {
+	SLNode* current = dummyHead;	//SLNode* to walk the list, starts at the dummy head
+	SLNode* nodeAfter = NULL;		//SLNode* to the Node after current
+	SLPrefix targetPrefix = prefixOf(target);
+	stats.beginSearch();
+
+	//loop walks the list starting at the top level and working its way down. If the
+	//Node after current is the end of the level or does not come before the target the
+	//search moves down one level from current. If the bottom level is reached the Node
+	//after current is returned.
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		stats.atLevel(currentLevel);
+		nodeAfter = current->next[currentLevel];
+		while (nodeAfter != NULL && nodeLess(nodeAfter, target, targetPrefix)) {
+			stats.moved();
+			current = nodeAfter;
+			nodeAfter = current->next[currentLevel];
 		}
+	}
+	return nodeAfter;
+}
 
-		if (currentLevel > 0) {					//if the current level is not the top
-			dummyHead[currentLevel - 1]->up = dummyHead[currentLevel];
-		}
+/*-------------------------------------------------------------------------------------------------
 
+	Method walks the list once from the top level down and records in update the last Node on
+	each level whose data is less than the target parameter (the dummy head if there is none).
+	Only one comparison is made per Node visited, and each step is reported to the statistics
+	policy. In an
+	indexed list the position of each recorded Node is stored in rank if it is not NULL, with
+	the dummy head at position 0. Method cannot change any data members other than stats.
+
+	POSTCONDITIONS:
+		- update[l] holds the Node the target would be sewn in after on level l, for every
+		  level in use
+		- rank[l] holds the position of update[l] in an indexed list
+		- returns the Node after update[0] on the master level, which is the Node containing
+		  the target if it is in the list, or NULL
 
-		dummyHead[currentLevel]->next = new SLNode;	//creates new SLNode
-		dummyHead[currentLevel]->next->isDummy = true;
-		dummyHead[currentLevel]->next->level = currentLevel;
-		dummyHead[currentLevel]->next->previous = dummyHead[currentLevel];
+-------------------------------------------------------------------------------------------------*/
 
-		if (currentLevel > 0) {						//if the current level is not the master level
-													//sets the down pointer to the dummy node below
-			dummyHead[currentLevel]->next->down = dummyHead[currentLevel - 1]->next;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::findPredecessors(const Target& target, SLNode** update, int* rank) const {
+	SLNode* current = dummyHead;	//SLNode* to walk the list, starts at the dummy head
+	SLNode* nodeAfter = NULL;		//SLNode* to the Node after current
+	int position = 0;				//position of current in an indexed list
+	SLPrefix targetPrefix = prefixOf(target);
+	stats.beginSearch();
+
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		stats.atLevel(currentLevel);
+		nodeAfter = current->next[currentLevel];
+		while (nodeAfter != NULL) {
+			if (!nodeLess(nodeAfter, target, targetPrefix)) {	//stops at the first Node not less than the target
+				break;
+			}
+			stats.moved();
+			if (Indexed) {
+				position += widths(current)[currentLevel];
+			}
+			current = nodeAfter;
+			nodeAfter = current->next[currentLevel];
 		}
-		if (currentLevel > 0) {					//if the current level is not the top
-			dummyHead[currentLevel - 1]->next->up = dummyHead[currentLevel]->next;
+		update[currentLevel] = current;
+		if (Indexed && rank != NULL) {
+			rank[currentLevel] = position;
 		}
 	}
-
+	return nodeAfter;
 };
 
 /*-------------------------------------------------------------------------------------------------
 
-	Overloaded operator equals. Walks the bottom level of the SkipList and compares the
-	Nodes to the Nodes in the parameter SkipList. Returns false at the first sign of
-	inequality. Method cannot change any data members.
+	Method walks an indexed list once from the top level down using the widths of the next
+	pointers, and records in update the last Node on each level before the Node at the 0-based
+	parameter index. Method cannot change any data members.
 
--------------------------------------------------------------------------------------------------*/
+	PRECONDITIONS:
+		- index is between 0 and size() - 1
 
-template<class Object>
-bool SkipList<Object>::operator==(const SkipList& toCompare) const {
-	//checks is either of the lists are empty or if one is empty
-	//and the other is not
-	if (this->isEmpty() && toCompare.isEmpty() == false) {
-		return false;
-	} else if (this->isEmpty() == false && toCompare.isEmpty()) {
-		return false;
-	} else if (this->isEmpty() && toCompare.isEmpty()) {
-		return true;
-	}
-	//returns false if they are not of the same size
-	if (this->size() != toCompare.size()) {
-		return false;
-	}
+	POSTCONDITIONS:
+		- update[l] holds the Node before the Node at index on level l, for every level in use
+		- returns the Node at index
+
+-------------------------------------------------------------------------------------------------*/
 
-	SLNode* thisList = dummyHead[0]->next;
-	SLNode* thatList = toCompare.dummyHead[0]->next;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::findIndex(int index, SLNode** update) const {
+	SLNode* current = dummyHead;	//SLNode* to walk the list, starts at the dummy head
+	int position = 0;				//position of current, the dummy head is at position 0
 
-	//walks the bottom level and compares each Node for equality
-	//returns false at the first sign of inequality
-	while (thisList->data != NULL) {
-		if (thisList->data != thatList->data) {
-			return false;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		while (current->next[currentLevel] != NULL && position + widths(current)[currentLevel] <= index) {
+			position += widths(current)[currentLevel];
+			current = current->next[currentLevel];
 		}
-		thisList = thisList->next;
-		thatList = thatList->next;
+		update[currentLevel] = current;
 	}
-	return true;
+	return current->next[0];
 };
 
 /*-------------------------------------------------------------------------------------------------
-	
-	Overloaded assignment operator. Makes a deep copy of the parameter list.
 
-	POSTCONDITIONS:
-		- creates a deep copy of the parameter list
+	Method returns a pointer to the widths stored after the next pointers of a Node in an
+	indexed list. widths(node)[l] is the number of master level steps from node to
+	node->next[l], or to one past the last Node if node->next[l] is NULL.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::widths(SLNode* node) {
+	return reinterpret_cast<int*>(node->next + node->level + 1);
+};
+
+/*-------------------------------------------------------------------------------------------------
 
-	NOTES:	List will not have all the same nodes at all the same levels. Only the master
-			level is copied.
+	Method points every level of a finger at the dummy head, so that the next finger search
+	starts from the top of the list. Method cannot change any data members.
 
 -------------------------------------------------------------------------------------------------*/
 
-template<class Object>
-void SkipList<Object>::operator=(const SkipList& toCopy) {
-	if (*this == toCopy) {	//bails if the parameter list is equal to this
-		return;
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::resetFinger(SLNode** finger, int* fingerRank) const {
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		finger[currentLevel] = dummyHead;
+		fingerRank[currentLevel] = 0;
 	}
+};
 
-	this->makeEmpty();	//deallocates all memory in the list
-	SLNode* current;
-	Object toInsert;
+/*-------------------------------------------------------------------------------------------------
 
-	if (toCopy.isEmpty()) {		//bails if the parameter list is empty
-		return;
-	}
+	Method searches for the target parameter starting from a finger left by the previous search,
+	where finger[l] is the last Node on level l before the previous target. If the Node on the
+	master level of the finger is not less than the target the finger is reset to the dummy head.
+	Otherwise the search climbs the finger while the Node after it on the next level up is still
+	less than the target, and walks down from there, so only the part of the list between the
+	previous target and this target is visited. The Node after the current Node is prefetched
+	while it is compared. Method cannot change any data members other than stats.
 
-	current = toCopy.dummyHead[0]->next;	//walks the parameter master level and 
-	while (current->isDummy == false) {		//inserts each Node in to the new list
-		toInsert = current->data;
-		insert(toInsert);
-		current = current->next;
+	POSTCONDITIONS:
+		- finger[l] holds the last Node on level l before the target, and fingerRank[l] its
+		  position in an indexed list, for every level in use
+		- returns the Node containing the target if it is in the list, or the Node after it,
+		  or NULL
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::fingerSearch(const Object& target, SLNode** finger, int* fingerRank) const {
+	SLPrefix targetPrefix = prefixOf(target);
+	stats.beginSearch();
+	if (finger[0] != dummyHead && !nodeLess(finger[0], target, targetPrefix)) {	//the finger is not before the target
+		resetFinger(finger, fingerRank);
+	}
+
+	//climbs the finger while the next level up still has to move
+	//right to reach the target
+	int startLevel = 0;
+	while (startLevel + 1 < levels) {
+		SLNode* nodeAfter = finger[startLevel + 1]->next[startLevel + 1];
+		if (nodeAfter == NULL || !nodeLess(nodeAfter, target, targetPrefix)) {
+			break;
+		}
+		startLevel++;
+	}
+
+	SLNode* current = finger[startLevel];
+	int position = fingerRank[startLevel];
+	SLNode* nodeAfter = NULL;
+	for (int currentLevel = startLevel; currentLevel > -1; currentLevel--) {
+		stats.atLevel(currentLevel);
+		nodeAfter = current->next[currentLevel];
+		while (nodeAfter != NULL) {
+			SL_PREFETCH(nodeAfter->next[currentLevel]);
+			if (!nodeLess(nodeAfter, target, targetPrefix)) {	//stops at the first Node not less than the target
+				break;
+			}
+			stats.moved();
+			if (Indexed) {
+				position += widths(current)[currentLevel];
+			}
+			current = nodeAfter;
+			nodeAfter = current->next[currentLevel];
+		}
+		finger[currentLevel] = current;
+		fingerRank[currentLevel] = position;
+	}
+	return nodeAfter;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method looks up every Object in the range [first, last) and writes a bool value for each to
+	the found output iterator, in the same order, indicating if it is in the list. Calls
+	fingerSearch as a helper function, so a sorted batch is searched in one left to right sweep.
+	Objects the membership filter rejects are skipped without moving the finger. Method cannot
+	change any data members.
+
+	POSTCONDITIONS:
+		- writes one bool per Object to found
+		- returns the number of Objects that are in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class InputIterator, class OutputIterator>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::contains_batch(InputIterator first, InputIterator last, OutputIterator found) const {
+	SLNode* finger[MAX_LEVEL];
+	int fingerRank[MAX_LEVEL];
+	resetFinger(finger, fingerRank);
+
+	int hits = 0;
+	bool filtered = filter.active();
+	for (; first != last; ++first) {
+		const Object& target = *first;
+		if (filtered && !filter.mayContain(target)) {	//the finger stays where it was
+			stats.filterRejected();
+			*found = false;
+			++found;
+			continue;
+		}
+		SLNode* nodeAfter = fingerSearch(target, finger, fingerRank);
+		bool isInList = isMatch(nodeAfter, target);
+		if (filtered) {
+			stats.filterPassed(isInList);
+		}
+		*found = isInList;
+		++found;
+		if (isInList) {
+			hits++;
+		}
+	}
+	return hits;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method inserts every Object in the range [first, last) that is not already in the list.
+	Calls fingerSearch as a helper function and sews each new Node in after the finger, so a
+	sorted batch is inserted in one left to right sweep.
+
+	POSTCONDITIONS:
+		- every Object in the range is in the list
+		- returns the number of Objects that were inserted
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class InputIterator>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::insert_batch(InputIterator first, InputIterator last) {
+	SLNode* finger[MAX_LEVEL];
+	int fingerRank[MAX_LEVEL];
+	resetFinger(finger, fingerRank);
+
+	int inserted = 0;
+	for (; first != last; ++first) {
+		const Object& toInsert = *first;
+		SLNode* nodeAfter = fingerSearch(toInsert, finger, fingerRank);
+		if (isMatch(nodeAfter, toInsert)) {
+			continue;
+		}
+		linkNode(createNode(toInsert, randomLevel()), finger, fingerRank);
+		inserted++;
+	}
+	return inserted;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object in the range [first, last) that is in the list. Calls
+	fingerSearch as a helper function and unlinks each Node using the finger, so a sorted batch
+	is removed in one left to right sweep. Objects that are not in the list are skipped quietly.
+
+	POSTCONDITIONS:
+		- no Object in the range is in the list
+		- returns the number of Objects that were removed
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class InputIterator>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::remove_batch(InputIterator first, InputIterator last) {
+	SLNode* finger[MAX_LEVEL];
+	int fingerRank[MAX_LEVEL];
+	resetFinger(finger, fingerRank);
+
+	int removed = 0;
+	for (; first != last; ++first) {
+		const Object& toRemove = *first;
+		SLNode* toDelete = fingerSearch(toRemove, finger, fingerRank);
+		if (isMatch(toDelete, toRemove)) {
+			unlinkNode(toDelete, finger);
+			removed++;
+		}
+	}
+	return removed;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a bool value indicating if the target Object is in the SkipList. If the list
+	has a membership filter and it rejects the target the method returns false without a search.
+	Otherwise retrieve() is called as a helper method and the data of the Node returned is
+	evaluated for equality with the target parameter. Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- returns a bool value indicating if the target is in the SkipList
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::contains(const Object& target) const  {
+	bool filtered = filter.active();
+	if (filtered && !filter.mayContain(target)) {	//the filter is certain the target is missing
+		stats.filterRejected();
+		return false;
+	}
+	SLNode* temp = retrieve(target);	//attempts to retrieve the target parameter
+	bool isInList = (temp != NULL && isMatch(temp, target));	//the search may run off the end of the master level
+	if (filtered) {
+		stats.filterPassed(isInList);
+	}
+	return isInList;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an int value corresponding to the number of nodes in the master level. The
+	count is kept up to date by every method that adds or removes Nodes, so the list is not
+	walked, except after split or join on a list that is not indexed, which leave the count out
+	of date. The master level is then counted once and the count is kept up to date again.
+	Method cannot change any data members other than the cached count.
+
+	POSTCONDITIONS:
+		- returns an int value corresponding to the number of Nodes in the master level
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::size(void) const {
+	if (countStale) {
+		count = 0;
+		for (SLNode* current = dummyHead->next[0]; current != NULL; current = current->next[0]) {
+			count++;
+		}
+		countStale = false;
+	}
+	return count;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a bool value indicating if there are any Nodes in the master level.
+	Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- returns false if there are no Nodes in the master level
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::isEmpty(void) const {
+	return levelIsEmpty(0);	//returns if the dummy head points past the end of the master level
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates all dynamically allocated memory for Nodes other than the dummy head
+	node. Calls clear as a helper function
+
+	POSTCONDITIONS:
+		- deletes all non-dummy nodes in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::makeEmpty(void) {
+	if (isEmpty()) {	//bails if the list is already empty
+		return;
+	}
+	clear();			//calls clear
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates all dynamically allocated memory for Nodes other than the dummy head
+	node. Since every element is a single Node only the master level has to be walked. If the
+	allocator can release all of its memory at once the Nodes are not deallocated one at a
+	time, and if the Objects are also trivially destructible the list is not walked at all.
+	Otherwise calls deleteNode as a helper function.
+
+	POSTCONDITIONS:
+		- deletes all non-dummy nodes in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::clear(void) {
+
+	SLNode* current = dummyHead->next[0];	//SLNode to keep track of the current node
+	SLNode* toDelete;
+
+	if (Allocator::bulkRelease) {
+		//destroys the Objects in place, then drops every slab at once
+		if (!is_trivially_destructible<Object>::value) {
+			for (; current != NULL; current = current->next[0]) {
+				current->data.~Object();
+			}
+		}
+		allocator.release();
+		stats.releasedAll();
+	} else {
+		//while loop that continues until the end of the master level is
+		//reached. deletes each node on the master level
+		while (current != NULL) {
+			toDelete = current;
+			current = current->next[0];
+			deleteNode(toDelete);
+		}
+	}
+
+	detachNodes();	//points the dummy head at the end of every level
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method points every level of the dummy head at the end of the level and drops the upper
+	levels, without touching the Nodes that were in the list. The caller must already have
+	deleted the Nodes or taken them over. The membership filter, if any, is cleared.
+
+	POSTCONDITIONS:
+		- the list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::detachNodes(void) {
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		dummyHead->next[currentLevel] = NULL;
+		if (Indexed) {
+			widths(dummyHead)[currentLevel] = 1;
+		}
+	}
+	count = 0;
+	countStale = false;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		heights[currentLevel] = 0;
+	}
+	heightsStale = false;
+	rebalanceAt = NULL;
+	rebalancing = false;
+	rebalancePosition = 0;
+	trimLevels();	//drops the now empty upper levels
+	if (filter.enabled()) {
+		filter.reset(0);
+		stats.filterResized(filter.bytes());
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates every Node in the list and replaces them with the Objects in the range
+	[first, last), which must be sorted in ascending order. Builds the list in one O(n) pass
+	using appendSorted as a helper function.
+
+	POSTCONDITIONS:
+		- the list holds every distinct Object in the range
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class InputIterator>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::assign_sorted(InputIterator first, InputIterator last) {
+	makeEmpty();
+	appendSorted(first, last);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method writes the list to a snapshot file at the parameter path, replacing any file there.
+	The master level is walked once and each Object is streamed to disk with the level of its
+	Node, so no copy of the list is made. Throws runtime_error if the file can not be written.
+
+	POSTCONDITIONS:
+		- the file at path is a snapshot of the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::save(const string& path) const {
+	SLSnapshotWriter<Object> writer(path, (uint64_t)size());
+	for (SLNode* current = dummyHead->next[0]; current != NULL; current = current->next[0]) {
+		writer.append(current->data, current->level);
+	}
+	writer.finish();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method maps the snapshot file at the parameter path read-only and returns a view of it that
+	can be searched with the default comparator straight away. Nothing is read until it is
+	used. Throws runtime_error if the file is not a snapshot of this Object type.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SLMappedSnapshot<Object, Compare> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::open_mapped(const string& path) {
+	return SLMappedSnapshot<Object, Compare>(path);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates every Node in the list and replaces them with the Objects of the parameter
+	snapshot in one O(n) pass. Each Object is given the height it was saved with and linked after
+	the last Node on every level, so the list has the same shape as the list that was saved. The
+	checksums of the snapshot are checked on the way, and every Object is compared to the one
+	before it to make sure the snapshot was saved in the order of this list's comparator.
+
+	POSTCONDITIONS:
+		- the list holds every Object of the snapshot
+		- throws runtime_error and leaves the list empty if the snapshot is corrupt or out of
+		  order
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::assign_snapshot(const SLMappedSnapshot<Object, Compare>& snapshot) {
+	makeEmpty();
+
+	SLNode* tails[MAX_LEVEL];	//last Node on each level
+	int tailRank[MAX_LEVEL];	//position of each Node in tails, indexed lists only
+	findTails(tails, tailRank);
+
+	SLChecksum keysChecksum, heightsChecksum;
+	bool sorted = true;
+	for (size_t i = 0; i < snapshot.size() && sorted; i++) {
+		const Object& key = snapshot[i];
+		unsigned char height = (unsigned char)snapshot.height(i);
+		keysChecksum.add(&key, sizeof(Object));
+		heightsChecksum.add(&height, 1);
+		if (tails[0] != dummyHead && !nodeLess(tails[0], key, prefixOf(key))) {
+			sorted = false;
+			break;
+		}
+		appendNode(createNode(key, (height < MAX_LEVEL) ? height : MAX_LEVEL - 1), tails, tailRank);
+	}
+	finishAppend(tails, tailRank);
+
+	const SLSnapshotHeader& header = snapshot.getHeader();
+	if (!sorted || keysChecksum.value() != header.keysChecksum || heightsChecksum.value() != header.heightsChecksum) {
+		makeEmpty();
+		throw runtime_error(sorted ? "SkipList::assign_snapshot: checksum mismatch" : "SkipList::assign_snapshot: snapshot is not sorted");
+	}
+	rebuild_filter();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds the Objects in the range [first, last) to the end of the list. Each Object is
+	compared to the last Object in the list and, if it is greater, given a random height and
+	linked after the last Node of every level it is on. An Object equal to the last Object is
+	skipped, and an Object less than it is inserted with insert, after which the last Node on
+	each level is found again. The membership filter is rebuilt once at the end.
+
+	POSTCONDITIONS:
+		- the list holds every distinct Object in the range
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class InputIterator>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::appendSorted(InputIterator first, InputIterator last) {
+	SLNode* tails[MAX_LEVEL];	//last Node on each level
+	int tailRank[MAX_LEVEL];	//position of each Node in tails, indexed lists only
+	findTails(tails, tailRank);
+
+	for (; first != last; ++first) {
+		const Object& toAppend = *first;
+		SLPrefix appendPrefix = prefixOf(toAppend);
+		if (tails[0] != dummyHead && !nodeLess(tails[0], toAppend, appendPrefix)) {	//the range is not sorted here
+			if (nodeGreater(tails[0], toAppend, appendPrefix)) {	//skips duplicates of the last Object
+				finishAppend(tails, tailRank);
+				insert(toAppend);
+				findTails(tails, tailRank);
+			}
+			continue;
+		}
+		appendNode(createNode(toAppend, randomLevel()), tails, tailRank);
+	}
+	finishAppend(tails, tailRank);
+	rebuild_filter();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method records the last Node on each level of the list in tails, the dummy head for levels
+	that are empty or not in use. In an indexed list the position of each recorded Node is
+	stored in tailRank. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::findTails(SLNode** tails, int* tailRank) const {
+	SLNode* current = dummyHead;
+	int position = 0;
+	for (int currentLevel = MAX_LEVEL - 1; currentLevel > -1; currentLevel--) {
+		if (currentLevel < levels) {
+			while (current->next[currentLevel] != NULL) {
+				if (Indexed) {
+					position += widths(current)[currentLevel];
+				}
+				current = current->next[currentLevel];
+			}
+		}
+		tails[currentLevel] = current;
+		tailRank[currentLevel] = position;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method links the parameter Node, whose Object must be greater than every Object in the list,
+	after the last Node on every level it is on, adding a level to the list if the Node is taller
+	than the list. tails and tailRank are updated so that the Node becomes the last Node on each
+	of its levels. The widths of the last Nodes are left for finishAppend to fix.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::appendNode(SLNode* node, SLNode** tails, int* tailRank) {
+	while (node->level >= levels) {
+		tails[levels] = dummyHead;
+		tailRank[levels] = 0;
+		addLevel();
+	}
+	count++;
+	heights[node->level]++;
+	node->previous = (tails[0] == dummyHead) ? NULL : tails[0];
+	for (int currentLevel = 0; currentLevel <= node->level; currentLevel++) {
+		tails[currentLevel]->next[currentLevel] = node;
+		if (Indexed) {
+			widths(tails[currentLevel])[currentLevel] = count - tailRank[currentLevel];
+		}
+		tails[currentLevel] = node;
+		tailRank[currentLevel] = count;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method sets the width of the last Node on each level of an indexed list so that it spans to
+	one past the last Node. Called once a run of appendNode calls is done.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::finishAppend(SLNode** tails, int* tailRank) {
+	if (Indexed) {
+		for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+			widths(tails[currentLevel])[currentLevel] = count + 1 - tailRank[currentLevel];
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a bool value indicating if the level of the list is empty, has no nodes
+	other than the dummy head node. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::levelIsEmpty(const int currentLevel) const {
+	return dummyHead->next[currentLevel] == NULL;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of bytes needed for a Node on level l, which is the fixed part of
+	the Node plus one next pointer per level above the master level, plus one width per level
+	in an indexed list, rounded up so that Nodes
+	carved one after another from a slab stay aligned.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+size_t SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::nodeSize(int l) {
+	size_t bytes = sizeof(SLNode) + l * sizeof(SLNode*);
+	if (Indexed) {
+		bytes += (l + 1) * sizeof(int);		//widths follow the next pointers
+	}
+	return (bytes + alignof(SLNode) - 1) / alignof(SLNode) * alignof(SLNode);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method allocates a single block of memory for a Node on level l from the allocator and copies
+	the parameter Object in to it. Calls emplaceNode as a helper function.
+
+	POSTCONDITIONS:
+		- returns a SLNode* to the new Node
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::createNode(const Object& d, int l) {
+	return emplaceNode(l, d);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method allocates a single block of memory for a Node on level l from the allocator and
+	constructs the Object in place inside of it from the parameter arguments, so the Object is
+	never copied. All pointers of the new Node are initialized to NULL.
+
+	POSTCONDITIONS:
+		- returns a SLNode* to the new Node
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class... Args>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::emplaceNode(int l, Args&&... args) {
+	SLNode* newNode = static_cast<SLNode*>(allocator.allocate(nodeSize(l)));
+	stats.allocated(l, nodeSize(l));
+	new (&newNode->data) Object(std::forward<Args>(args)...);	//builds the Object in the Node
+	if constexpr (Traits::hasPrefix) {
+		newNode->prefix = Traits::prefix(compare, newNode->data);	//caches the prefix of the Object
+	}
+	newNode->previous = NULL;
+	newNode->level = l;
+	for (int currentLevel = 0; currentLevel <= l; currentLevel++) {
+		newNode->next[currentLevel] = NULL;
+	}
+	return newNode;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates all memory for the Node passed through as a parameter by handing it back
+	to the allocator. The Node must already have been unlinked from every level it is on.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::deleteNode(SLNode*& toClear) {
+	if (toClear == NULL) {	//checks if toClear is NULL
+		return;				//bails
+	}
+	if (toClear == rebalanceAt) {			//the next rebalance slice starts at the Node after instead
+		rebalanceAt = toClear->next[0];
+	}
+	toClear->data.~Object();							//destroys toClear's data
+	stats.deallocated(toClear->level, nodeSize(toClear->level));
+	allocator.deallocate(toClear, nodeSize(toClear->level));	//also deletes toClear
+	toClear = NULL;					//sets toClear to NULL
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Takes in an object and calls findPredecessors to search for it and record the Node before it
+	on every level in a single pass. If the object is in the SkipList the Node is unlinked from
+	every level it is on by pointing the recorded Nodes past it, then removed via unlinkNode. A
+	bool value is returned indicating whether the Node was successfully removed from the list.
+
+	POSTCONDITIONS:
+		- removes the node containing the data member equal to the target parameter from the
+		  list
+		- returns a bool value indicating success
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::remove(const Object& toRemove) {
+
+	SLNode* update[MAX_LEVEL];								//last Node before toRemove on each level
+	SLNode* toDelete = findPredecessors(toRemove, update);	//will hold SLNode* to the node containing toRemove
+
+	if (isMatch(toDelete, toRemove)) {						//if the object is in the list
+		unlinkNode(toDelete, update);						//unlinks and deletes the node
+		return true;
+	}
+
+	return false;							//returns false if the object was not in the list
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method unlinks the parameter Node from every level it is on, using the Nodes before it
+	recorded in update, and deletes it via deleteNode. In an indexed list the widths of the
+	recorded Nodes are adjusted to skip one less Node.
+
+	POSTCONDITIONS:
+		- toDelete is no longer in the list and its memory is deallocated
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::unlinkNode(SLNode* toDelete, SLNode** update) {
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		if (currentLevel <= toDelete->level) {
+			update[currentLevel]->next[currentLevel] = toDelete->next[currentLevel];
+			if (Indexed) {
+				widths(update[currentLevel])[currentLevel] += widths(toDelete)[currentLevel] - 1;
+			}
+		} else if (Indexed) {
+			widths(update[currentLevel])[currentLevel]--;
+		} else {
+			break;
+		}
+	}
+	if (toDelete->next[0] != NULL) {		//sews the previous pointer of the Node after
+		toDelete->next[0]->previous = toDelete->previous;
+	}
+	heights[toDelete->level]--;
+	deleteNode(toDelete);					//deletes the node
+	count--;
+	trimLevels();							//drops any levels the Node was the last member of
+	filterErase();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method unlinks a run of consecutive Nodes from every level and deletes them. before[l] must
+	be the last Node on level l before the run and last[l] the last Node of the run on level l,
+	or before[l] if no Node of the run is on that level, and in an indexed list beforeRank and
+	lastRank hold their positions. Each level is relinked once by pointing before[l] past
+	last[l], and in an indexed list its width grows by the width of last[l] and shrinks by the
+	length of the run. The Nodes are then deleted in one walk of the master level, and the
+	size, height histogram, and membership filter are updated once for the whole run.
+
+	POSTCONDITIONS:
+		- the Nodes of the run are unlinked and deallocated
+		- returns the number of Nodes that were deleted
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::cutSpan(SLNode** before, int* beforeRank, SLNode** last, int* lastRank) {
+	SLNode* first = before[0]->next[0];		//first Node of the run
+	SLNode* after = last[0]->next[0];		//first Node after the run
+	if (first == after) {
+		return 0;
+	}
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		if (Indexed) {
+			int span = lastRank[currentLevel] + widths(last[currentLevel])[currentLevel] - beforeRank[currentLevel];
+			widths(before[currentLevel])[currentLevel] = span - (lastRank[0] - beforeRank[0]);
+		}
+		before[currentLevel]->next[currentLevel] = last[currentLevel]->next[currentLevel];
+	}
+	if (after != NULL) {
+		after->previous = (before[0] == dummyHead) ? NULL : before[0];	//the first Node has no previous Node
+	}
+
+	int removed = 0;
+	while (first != after) {
+		SLNode* toDelete = first;
+		first = first->next[0];
+		heights[toDelete->level]--;
+		deleteNode(toDelete);
+		removed++;
+	}
+	count -= removed;
+	trimLevels();
+	filterErase(removed);
+	return removed;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in an indexed list that are less than the target
+	parameter, which is the 0-based index of the target if it is in the list. Runs in O(logn).
+	Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- returns the 0-based index the target has or would have in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::rank(const Object& target) const {
+	static_assert(Indexed, "rank requires an indexed SkipList");
+	SLNode* update[MAX_LEVEL];
+	int position[MAX_LEVEL];
+	findPredecessors(target, update, position);
+	return position[0];
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the Object at the 0-based parameter index of an indexed list. Runs in
+	O(logn). Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- returns the Object at index
+		- throws out_of_range if index is not between 0 and size() - 1
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+const Object& SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::at(int index) const {
+	static_assert(Indexed, "at requires an indexed SkipList");
+	if (index < 0 || index >= count) {
+		throw out_of_range("SkipList::at");
+	}
+	SLNode* update[MAX_LEVEL];
+	return findIndex(index, update)->data;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the Object at the 0-based parameter index of an indexed list. Runs in
+	O(logn). Returns a bool value indicating whether an Object was removed.
+
+	POSTCONDITIONS:
+		- removes the Node at index from the list
+		- returns false if index is not between 0 and size() - 1
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::erase_at(int index) {
+	static_assert(Indexed, "erase_at requires an indexed SkipList");
+	if (index < 0 || index >= count) {
+		return false;
+	}
+	SLNode* update[MAX_LEVEL];
+	unlinkNode(findIndex(index, update), update);
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the smallest Object in the list, which is the Object in the first Node on the
+	master level, in O(1). Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- returns the smallest Object
+		- throws out_of_range if the list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+const Object& SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::peek_min(void) const {
+	if (dummyHead->next[0] == NULL) {
+		throw out_of_range("SkipList::peek_min");
+	}
+	return dummyHead->next[0]->data;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the smallest Object from the list and returns it, moved out of its Node. The
+	first Node comes right after the dummy head on every level it is on, so it is unlinked there
+	without a search or a comparison, in O(height of the Node). Returns an empty optional if the
+	list is empty.
+
+	POSTCONDITIONS:
+		- the smallest Object is removed from the list and returned
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+optional<Object> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::pop_min(void) {
+	SLNode* first = dummyHead->next[0];
+	if (first == NULL) {
+		return nullopt;
+	}
+	SLNode* update[MAX_LEVEL];
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		update[currentLevel] = dummyHead;
+	}
+	optional<Object> popped(std::move(first->data));
+	unlinkNode(first, update);
+	return popped;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the largest Object from the list and returns it, moved out of its Node. The
+	Nodes before the last Node are found by walking along the end of each level from the top
+	level down and stopping before the last Node, which takes O(logn) steps and no comparisons.
+	Returns an empty optional if the list is empty.
+
+	POSTCONDITIONS:
+		- the largest Object is removed from the list and returned
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+optional<Object> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::pop_max(void) {
+	SLNode* update[MAX_LEVEL];
+	SLNode* current = dummyHead;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		//moves right until the next Node on the level is the last Node or the end
+		while (current->next[currentLevel] != NULL && current->next[currentLevel]->next[0] != NULL) {
+			current = current->next[currentLevel];
+		}
+		update[currentLevel] = current;
+	}
+	SLNode* last = update[0]->next[0];
+	if (last == NULL) {
+		return nullopt;
+	}
+	optional<Object> popped(std::move(last->data));
+	unlinkNode(last, update);
+	return popped;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object in the half-open range [low, high). One search finds the last
+	Node before low on each level and another the last Node before high, then the whole run of
+	Nodes between them is cut out of every level at once and deallocated in one walk of the
+	master level (see cutSpan), so the method runs in O(logn + k) for k Objects removed. Does
+	nothing if low is not less than high.
+
+	POSTCONDITIONS:
+		- no Object in [low, high) is in the list
+		- returns the number of Objects that were removed
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::erase_range(const Object& low, const Object& high) {
+	if (!compare(low, high)) {
+		return 0;
+	}
+	SLNode* before[MAX_LEVEL];	//last Node before low on each level
+	int beforeRank[MAX_LEVEL];
+	SLNode* last[MAX_LEVEL];	//last Node before high on each level
+	int lastRank[MAX_LEVEL];
+	findPredecessors(low, before, beforeRank);
+	findPredecessors(high, last, lastRank);
+	return cutSpan(before, beforeRank, last, lastRank);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes every Object less than the parameter key, such as every timer that has
+	expired. The run to remove starts right after the dummy head, so one search for the key is
+	enough to cut it out of every level (see cutSpan). Runs in O(logn + k) for k Objects
+	removed.
+
+	POSTCONDITIONS:
+		- no Object less than key is in the list
+		- returns the number of Objects that were removed
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::erase_until(const Object& key) {
+	SLNode* before[MAX_LEVEL];
+	int beforeRank[MAX_LEVEL];
+	SLNode* last[MAX_LEVEL];
+	int lastRank[MAX_LEVEL];
+	resetFinger(before, beforeRank);
+	findPredecessors(key, last, lastRank);
+	return cutSpan(before, beforeRank, last, lastRank);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Nodes whose top level is l, for every level l in use. The
+	histogram is kept up to date as Nodes are linked and unlinked, so the list is not walked,
+	except after a split, which leaves it out of date on both sides. The master level is then
+	walked once. Method cannot change any data members other than the cached histogram.
+
+	POSTCONDITIONS:
+		- returns a vector of levels ints that add up to size()
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+vector<int> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::level_histogram(void) const {
+	if (heightsStale) {
+		countHeights();
+	}
+	return vector<int>(heights, heights + levels);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns how far the heights of the Nodes are from the ideal geometric distribution,
+	in which n p^l of the n Nodes reach level l. The number of Nodes reaching each level above
+	the master level is compared with the ideal number, and the result is the sum of the
+	differences over the sum of the ideal numbers: 0 for a list with the ideal shape, around
+	0.1 or less for random heights in a large list, and 1 or more for a list whose upper levels
+	have mostly been removed or are far too crowded. Uses the height histogram, so it runs in
+	O(levels) unless the histogram is out of date. Method cannot change any data members other
+	than the cached histogram.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+double SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::skew(void) const {
+	if (heightsStale) {
+		countHeights();
+	}
+	int n = size();
+	if (n < 2) {
+		return 0.0;
+	}
+	double reaching = n;			//Nodes on level l or above
+	double ideal = n;				//ideal number of Nodes on level l or above
+	double difference = 0.0;
+	double idealTotal = 0.0;
+	for (int currentLevel = 1; currentLevel < MAX_LEVEL; currentLevel++) {
+		reaching -= heights[currentLevel - 1];
+		ideal *= probability;
+		if (ideal < 1.0 && reaching == 0) {
+			break;
+		}
+		difference += (reaching > ideal) ? reaching - ideal : ideal - reaching;
+		idealTotal += ideal;
+	}
+	return (idealTotal > 0.0) ? difference / idealTotal : 0.0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method gives up to budget Nodes the height they would have in the ideal list, continuing
+	from where the previous call stopped. The Node at position i of the master level, counting
+	from 1, is put on the level equal to the number of times b divides i, where b is 1/p
+	rounded to the nearest int, so 1 in b Nodes reaches level 1, 1 in b^2 reaches level 2, and
+	so on. A Node whose height changes is replaced by a new Node of the right height that the
+	Object is moved in to (see retowerNode). The list remembers the Node a call stopped at, which
+	deleteNode moves on to the next Node if it is removed, and the next call finds the Nodes
+	before it with one search for its Object, so the list can be changed freely between calls
+	and nothing is copied. Nodes inserted behind the point reached keep their random height
+	until the next pass, and in a list that is not indexed the positions drift by the number of
+	Objects inserted or removed behind that point. Each call runs in O(logn + budget). Returns true once the end of
+	the list is reached, and the next call starts a new pass from the first Node.
+
+	POSTCONDITIONS:
+		- up to budget more Nodes have their ideal height
+		- returns true if the pass is done
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::rebalance(int budget) {
+	SLNode* update[MAX_LEVEL];	//last Node before current on each level
+	int rank[MAX_LEVEL];		//position of each Node in update, indexed lists only
+	SLNode* current;
+	int position;				//position of the last Node handled
+	if (rebalancing) {
+		resetFinger(update, rank);
+		current = rebalanceAt;
+		if (current != NULL) {
+			findPredecessors(current->data, update, rank);
+		}
+		position = Indexed ? rank[0] : rebalancePosition;
+	} else {
+		resetFinger(update, rank);
+		current = dummyHead->next[0];
+		position = 0;
+	}
+
+	for (int handled = 0; current != NULL && handled < budget; handled++) {
+		position++;
+		int nodeLevel = idealLevel(position);
+		if (nodeLevel != current->level) {
+			current = retowerNode(current, nodeLevel, update, rank);
+		}
+		for (int currentLevel = 0; currentLevel <= current->level; currentLevel++) {
+			update[currentLevel] = current;
+			rank[currentLevel] = position;
+		}
+		current = current->next[0];
+	}
+	trimLevels();		//drops levels whose last Node was lowered
+
+	if (current == NULL) {
+		rebalanceAt = NULL;
+		rebalancing = false;
+		rebalancePosition = 0;
+		return true;
+	}
+	rebalanceAt = current;
+	rebalancing = true;
+	rebalancePosition = position;
+	return false;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method counts the Nodes whose top level is each level by walking the master level once.
+	Method cannot change any data members other than the cached histogram.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::countHeights(void) const {
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		heights[currentLevel] = 0;
+	}
+	for (SLNode* current = dummyHead->next[0]; current != NULL; current = current->next[0]) {
+		heights[current->level]++;
+	}
+	heightsStale = false;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the level of the Node at the parameter position, counting from 1, in the
+	ideal list: the number of times 1/p, rounded to an int of at least 2, divides the position.
+	The level is never more than one above the current top level or past MAX_LEVEL. Method
+	cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+int SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::idealLevel(int position) const {
+	int base = (int)(1.0 / probability + 0.5);
+	if (base < 2) {
+		base = 2;
+	}
+	int nodeLevel = 0;
+	while (position % base == 0 && nodeLevel < levels && nodeLevel < MAX_LEVEL - 1) {
+		position /= base;
+		nodeLevel++;
+	}
+	return nodeLevel;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method replaces the parameter Node with a new Node on level l that the Object is moved in to,
+	and returns the new Node. update[k] must be the last Node before the old Node on each level
+	k, and rank[k] its position in an indexed list. On the levels both Nodes are on the new
+	Node takes over the old Node's pointers, on the levels only the new Node is on it is sewn in
+	after update[k], and on the levels only the old Node was on update[k] is pointed past it.
+	In an indexed list the widths are split or joined to match. A level is added to the list
+	if l is the current number of levels. The size of the list and its membership filter do
+	not change, since the Objects in the list are the same.
+
+	POSTCONDITIONS:
+		- the Object is in a Node on level l at the same position
+		- the old Node is deallocated
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::retowerNode(SLNode* node,
+	int l, SLNode** update, int* rank) {
+	if (l == levels) {		//a Node may only grow the list by one level at a time
+		update[levels] = dummyHead;
+		rank[levels] = 0;
+		addLevel();
+	}
+	SLNode* replacement = emplaceNode(l, std::move(node->data));
+	int position = rank[0] + 1;		//position of both Nodes
+	int top = (l > node->level) ? l : node->level;
+	for (int currentLevel = 0; currentLevel <= top; currentLevel++) {
+		if (currentLevel <= l && currentLevel <= node->level) {		//takes over the old Node's pointer
+			replacement->next[currentLevel] = node->next[currentLevel];
+			update[currentLevel]->next[currentLevel] = replacement;
+			if (Indexed) {
+				widths(replacement)[currentLevel] = widths(node)[currentLevel];
+			}
+		} else if (currentLevel <= l) {								//sews the new Node in
+			replacement->next[currentLevel] = update[currentLevel]->next[currentLevel];
+			update[currentLevel]->next[currentLevel] = replacement;
+			if (Indexed) {
+				int* before = widths(update[currentLevel]);
+				widths(replacement)[currentLevel] = rank[currentLevel] + before[currentLevel] - position;
+				before[currentLevel] = position - rank[currentLevel];
+			}
+		} else {													//skips the level the old Node leaves
+			update[currentLevel]->next[currentLevel] = node->next[currentLevel];
+			if (Indexed) {
+				widths(update[currentLevel])[currentLevel] += widths(node)[currentLevel];
+			}
+		}
+	}
+	replacement->previous = node->previous;
+	if (replacement->next[0] != NULL) {
+		replacement->next[0]->previous = replacement;
+	}
+	heights[node->level]--;
+	heights[l]++;
+	deleteNode(node);
+	return replacement;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the Node with the smallest Object in the list, or end() if the
+	list is empty. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_iterator SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::begin(void) const {
+	return const_iterator(dummyHead->next[0], this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator one past the Node with the largest Object in the list.
+	Decrementing it moves to the last Node. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_iterator SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::end(void) const {
+	return const_iterator(NULL, this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a reverse iterator to the Node with the largest Object in the list. Method
+	cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_reverse_iterator SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::rbegin(void) const {
+	return const_reverse_iterator(end());
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a reverse iterator one before the Node with the smallest Object in the list.
+	Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_reverse_iterator SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::rend(void) const {
+	return const_reverse_iterator(begin());
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first Node whose Object is not less than the target
+	parameter, or end() if there is none. Calls findPredecessors as a helper function. Method
+	cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_iterator SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::lower_bound(const Object& target) const {
+	SLNode* update[MAX_LEVEL];
+	return const_iterator(findPredecessors(target, update), this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first Node whose Object is greater than the target
+	parameter, or end() if there is none. Calls findGreater as a helper function. Method cannot
+	change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_iterator SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::upper_bound(const Object& target) const {
+	return const_iterator(findGreater(target), this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the range of Nodes whose Objects are equal to the target parameter as a pair
+	of iterators. Since the list holds no duplicates the range is empty or holds one Node, so
+	the end of the range is found by stepping once from the start instead of searching again.
+	Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+pair<typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_iterator, typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::const_iterator>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::equal_range(const Object& target) const {
+	const_iterator first = lower_bound(target);
+	const_iterator last = first;
+	if (isMatch(first.node, target)) {
+		++last;
+	}
+	return make_pair(first, last);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method calls the parameter function on every Object in the list that is not less than low
+	and less than high, in order. The start of the range is found with one search from the top
+	level and the rest of the range is walked on the master level, so the method runs in
+	O(logn + k) for k Objects in the range and copies nothing. The function must not insert in
+	to or remove from the list. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Function>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::for_each_in_range(const Object& low, const Object& high, Function visit) const {
+	SLNode* update[MAX_LEVEL];
+	SLPrefix highPrefix = prefixOf(high);
+	for (SLNode* current = findPredecessors(low, update); current != NULL; current = current->next[0]) {
+		if (!nodeLess(current, high, highPrefix)) {	//stops at the first Object not less than high
+			break;
+		}
+		visit(current->data);
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method walks the list once from the top level down and returns the first Node on the master
+	level whose Object is greater than the target parameter, or NULL if there is none. Only one
+	comparison is made per Node visited. Method cannot change any data members other than stats.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+template<class Target>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::findGreater(const Target& target) const {
+	SLNode* current = dummyHead;	//SLNode* to walk the list, starts at the dummy head
+	SLNode* nodeAfter = NULL;		//SLNode* to the Node after current
+	SLPrefix targetPrefix = prefixOf(target);
+	stats.beginSearch();
+
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		stats.atLevel(currentLevel);
+		nodeAfter = current->next[currentLevel];
+		while (nodeAfter != NULL) {
+			if (nodeGreater(nodeAfter, target, targetPrefix)) {		//stops at the first Node greater than the target
+				break;
+			}
+			stats.moved();
+			current = nodeAfter;
+			nodeAfter = current->next[currentLevel];
+		}
+	}
+	return nodeAfter;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the last Node on the master level, or NULL if the list is empty. The list is
+	walked along the end of each level from the top level down, which takes O(logn) steps and
+	no comparisons. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+typename SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::SLNode* SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::lastNode(void) const {
+	SLNode* current = dummyHead;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		while (current->next[currentLevel] != NULL) {
+			current = current->next[currentLevel];
+		}
+	}
+	return (current == dummyHead) ? NULL : current;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method initializes the dummy head node with a next pointer for every possible level. The
+	dummy head never holds an Object. Only the master level is in use until Nodes are promoted.
+
+	POSTCONDITIONS:
+		- initializes the dummy head node
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::initialize(void) {
+	dummyHead = static_cast<SLNode*>(::operator new(nodeSize(MAX_LEVEL - 1)));
+	dummyHead->previous = NULL;
+	dummyHead->level = MAX_LEVEL - 1;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		dummyHead->next[currentLevel] = NULL;
+		if (Indexed) {
+			widths(dummyHead)[currentLevel] = 1;	//the end of every level is one past the last Node
+		}
+	}
+	levels = 1;		//the master level is always in use
+	count = 0;
+	countStale = false;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		heights[currentLevel] = 0;
+	}
+	heightsStale = false;
+	rebalanceAt = NULL;
+	rebalancing = false;
+	rebalancePosition = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds a new, empty level on top of the list. In an indexed list the width of the new
+	level of the dummy head spans the whole list.
+
+	POSTCONDITIONS:
+		- adds one empty level to the top of the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::addLevel(void) {
+	dummyHead->next[levels] = NULL;
+	if (Indexed) {
+		widths(dummyHead)[levels] = count + 1;
+	}
+	levels++;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes empty levels from the top of the list so that searches do not start above
+	the tallest Node. The master level is never removed.
+
+	POSTCONDITIONS:
+		- the top level of the list contains at least one Node, or only the master level remains
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::trimLevels(void) {
+	while (levels > 1 && levelIsEmpty(levels - 1)) {
+		levels--;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded operator equals. Walks the bottom level of the SkipList and compares the
+	Nodes to the Nodes in the parameter SkipList with the comparator. Returns false at the first sign of
+	inequality. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+bool SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::operator==(const SkipList& toCompare) const {
+	//checks is either of the lists are empty or if one is empty
+	//and the other is not
+	if (this->isEmpty() && toCompare.isEmpty() == false) {
+		return false;
+	} else if (this->isEmpty() == false && toCompare.isEmpty()) {
+		return false;
+	} else if (this->isEmpty() && toCompare.isEmpty()) {
+		return true;
+	}
+	//returns false if they are not of the same size
+	if (this->size() != toCompare.size()) {
+		return false;
+	}
+
+	SLNode* thisList = dummyHead->next[0];
+	SLNode* thatList = toCompare.dummyHead->next[0];
+
+	//walks the bottom level and compares each Node for equality, two
+	//Objects are equal when neither comes before the other. Returns
+	//false at the first sign of inequality
+	while (thisList != NULL) {
+		if (compare(thisList->data, thatList->data) || compare(thatList->data, thisList->data)) {
+			return false;
+		}
+		thisList = thisList->next[0];
+		thatList = thatList->next[0];
+	}
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded assignment operator. Makes a deep copy of the parameter list in O(n). The master
+	level of the parameter list is walked once, and each Node is copied with the same height
+	and linked after the last Node on every level it is on, so the copy has the same shape as
+	the parameter list and no searches are needed. The copy takes the comparator and promotion
+	probability of the parameter list, and a copy of its membership filter, or has none if the
+	parameter list has none.
+
+	POSTCONDITIONS:
+		- creates a deep copy of the parameter list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::operator=(const SkipList& toCopy) {
+	if (this == &toCopy) {	//bails if the parameter list is this list
+		return;
+	}
+
+	this->makeEmpty();	//deallocates all memory in the list
+	compare = toCopy.compare;
+	probability = toCopy.probability;	//later inserts promote the way the copied towers were built
+
+	SLNode* tails[MAX_LEVEL];	//last Node on each level of the new list
+	int tailRank[MAX_LEVEL];
+	findTails(tails, tailRank);
+
+	//walks the parameter master level and appends a copy
+	//of each Node with the same height to the new list
+	for (SLNode* current = toCopy.dummyHead->next[0]; current != NULL; current = current->next[0]) {
+		appendNode(createNode(current->data, current->level), tails, tailRank);
+	}
+	finishAppend(tails, tailRank);
+	filter = toCopy.filter;		//the bits of the parameter list's filter cover the same Objects
+	stats.filterResized(filter.bytes());
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves every Node of the parameter list in to this list without allocating or copying
+	anything. The allocator of this list takes over the memory of the other list first, then the
+	master levels of both lists are walked in lockstep and each Node is linked after the last
+	Node on every level it is on, keeping its height. Runs in O(n + m). If both lists hold an
+	equal Object the Node of this list is kept and the other one is deleted. The membership
+	filter of this list is rebuilt once at the end.
+
+	POSTCONDITIONS:
+		- the list holds every Object that was in either list
+		- the parameter list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::merge(SkipList&& other) {
+	if (&other == this || other.isEmpty()) {
+		return;
+	}
+	allocator.absorb(other.allocator);
+
+	SLNode* mine = dummyHead->next[0];			//next Node of this list to link
+	SLNode* theirs = other.dummyHead->next[0];	//next Node of the other list to link
+	detachNodes();
+	other.detachNodes();
+
+	SLNode* tails[MAX_LEVEL];	//last Node on each level
+	int tailRank[MAX_LEVEL];	//position of each Node in tails, indexed lists only
+	findTails(tails, tailRank);
+
+	while (mine != NULL || theirs != NULL) {
+		SLNode* toLink;
+		if (theirs == NULL || (mine != NULL && !nodeBefore(theirs, mine))) {
+			if (theirs != NULL && !nodeBefore(mine, theirs)) {	//drops the other list's copy of an equal Object
+				SLNode* duplicate = theirs;
+				theirs = theirs->next[0];
+				other.stats.deallocated(duplicate->level, nodeSize(duplicate->level));
+				stats.allocated(duplicate->level, nodeSize(duplicate->level));
+				deleteNode(duplicate);
+			}
+			toLink = mine;
+			mine = mine->next[0];
+		} else {
+			toLink = theirs;
+			theirs = theirs->next[0];
+			other.stats.deallocated(toLink->level, nodeSize(toLink->level));
+			stats.allocated(toLink->level, nodeSize(toLink->level));
+		}
+		for (int currentLevel = 0; currentLevel <= toLink->level; currentLevel++) {
+			toLink->next[currentLevel] = NULL;
+		}
+		appendNode(toLink, tails, tailRank);
+	}
+	finishAppend(tails, tailRank);
+	rebuild_filter();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves every Object not less than the parameter key to a new list and returns it. The
+	list is cut after the last Node before the key on every level: the new list's dummy head
+	takes over the pointer that crossed the cut and the Node before the cut ends the level, so
+	only one pointer per level is relinked and no Node is touched. Runs in O(logn). The new list
+	shares the memory of the moved Nodes with this list (see slallocator.h), and has the same
+	promotion probability and comparator with a generator seeded from this one. In an indexed
+	list the widths at the cut give the size of both lists, otherwise both sizes are recounted
+	by the next call to size. The height histograms of both lists are recounted the next time
+	they are needed, unless every Node moved. With a statistics policy other than SLNoStats the
+	moved Nodes are walked once to move their part of the height histogram. The membership filter of this list
+	still covers every Object left in it. The new list gets a filter with the same hasher that
+	is built on its first insert or remove, or by rebuild_filter. A rebalance pass under way
+	ends at the cut if it had reached the moved Nodes.
+
+	POSTCONDITIONS:
+		- the list holds every Object less than key
+		- returns a list of every Object that was in the list and is not less than key
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::split(const Object& key) {
+	SkipList result(probability, compare);
+	result.seed(random());
+	result.filter.enableLike(filter);	//left stale, so the split stays O(logn)
+
+	SLNode* update[MAX_LEVEL];	//last Node before the cut on each level
+	int rank[MAX_LEVEL];		//position of each Node in update, indexed lists only
+	SLNode* first = findPredecessors(key, update, rank);
+	if (first == NULL) {		//every Object is less than key
+		return result;
+	}
+	result.allocator.share(allocator);
+	handOverStats(first, result);
+
+	while (result.levels < levels) {
+		result.addLevel();
+	}
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		result.dummyHead->next[currentLevel] = update[currentLevel]->next[currentLevel];
+		update[currentLevel]->next[currentLevel] = NULL;
+		if (Indexed) {	//the pointer across the cut ended at position rank + width
+			widths(result.dummyHead)[currentLevel] = rank[currentLevel] + widths(update[currentLevel])[currentLevel] - rank[0];
+			widths(update[currentLevel])[currentLevel] = rank[0] + 1 - rank[currentLevel];
+		}
+	}
+	first->previous = NULL;
+
+	if (Indexed) {
+		result.count = count - rank[0];
+		count = rank[0];
+	} else if (update[0] == dummyHead) {	//every Node moved, so the count moves with them
+		result.count = count;
+		result.countStale = countStale;
+		count = 0;
+		countStale = false;
+	} else {
+		result.countStale = true;
+		countStale = true;
+	}
+	if (update[0] == dummyHead) {			//and so does the height histogram
+		for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+			result.heights[currentLevel] = heights[currentLevel];
+			heights[currentLevel] = 0;
+		}
+		result.heightsStale = heightsStale;
+		heightsStale = false;
+	} else {
+		result.heightsStale = true;
+		heightsStale = true;
+	}
+	if (rebalanceAt != NULL && !compare(rebalanceAt->data, key)) {	//the rebalance pass ends at the cut
+		rebalanceAt = NULL;
+	}
+	trimLevels();
+	result.trimLevels();
+	return result;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves every Node of the parameter list in to this list when the Objects of one list
+	all come before the Objects of the other. The allocator of this list takes over the memory
+	of the other list, then the Nodes of the other list are linked after the last Node of this
+	list on every level (or before the first Node if they are smaller), relinking one pointer
+	per level. Runs in O(logn + logm). Lists whose ranges overlap are combined with merge
+	instead, in O(n + m). In a list that is not indexed the size is recounted by the next call
+	to size if either count was out of date. The membership filter of this list is not used
+	again until it is rebuilt by the next insert or remove, or by rebuild_filter.
+
+	POSTCONDITIONS:
+		- the list holds every Object that was in either list
+		- the parameter list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::join(SkipList&& other) {
+	if (&other == this || other.isEmpty()) {
+		return;
+	}
+	if (isEmpty() || nodeBefore(lastNode(), other.dummyHead->next[0])) {
+		allocator.absorb(other.allocator);
+		other.handOverStats(other.dummyHead->next[0], *this);
+		appendList(other);
+	} else if (nodeBefore(other.lastNode(), dummyHead->next[0])) {
+		allocator.absorb(other.allocator);
+		other.handOverStats(other.dummyHead->next[0], *this);
+		prependList(other);
+	} else {
+		merge(std::move(other));
+		return;
+	}
+	count += other.count;
+	countStale = countStale || other.countStale;
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		heights[currentLevel] += other.heights[currentLevel];
+	}
+	heightsStale = heightsStale || other.heightsStale;
+	filter.invalidate();		//the Objects of the other list are not in the filter
+	other.detachNodes();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method links the first Node on each level of the parameter list, whose Objects must all be
+	greater than the Objects of this list, after the last Node on that level of this list, and
+	adds levels to this list if the other list is taller. In an indexed list each relinked
+	pointer spans to the first Node of the other list, and the pointers that end the levels the
+	other list does not have are widened by its size. The count and the other list's dummy head
+	are left for the caller to fix.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::appendList(SkipList& other) {
+	SLNode* tails[MAX_LEVEL];	//last Node on each level
+	int tailRank[MAX_LEVEL];	//position of each Node in tails, indexed lists only
+	findTails(tails, tailRank);
+	while (levels < other.levels) {
+		tails[levels] = dummyHead;
+		tailRank[levels] = 0;
+		addLevel();
+	}
+	other.dummyHead->next[0]->previous = (tails[0] == dummyHead) ? NULL : tails[0];
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		if (currentLevel < other.levels) {
+			tails[currentLevel]->next[currentLevel] = other.dummyHead->next[currentLevel];
+			if (Indexed) {
+				widths(tails[currentLevel])[currentLevel] = count - tailRank[currentLevel] + widths(other.dummyHead)[currentLevel];
+			}
+		} else if (Indexed) {
+			widths(tails[currentLevel])[currentLevel] += other.count;
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method links the last Node on each level of the parameter list, whose Objects must all be
+	less than the Objects of this list, before the first Node on that level of this list, and
+	points the dummy head of this list at the first Node of the other list on each of its
+	levels. In an indexed list the pointers of this dummy head on the levels the other list
+	does not have are widened by its size. The count and the other list's dummy head are left
+	for the caller to fix.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::prependList(SkipList& other) {
+	SLNode* tails[MAX_LEVEL];	//last Node on each level of the other list
+	int tailRank[MAX_LEVEL];	//position of each Node in tails, indexed lists only
+	other.findTails(tails, tailRank);
+	while (levels < other.levels) {
+		addLevel();
+	}
+	if (dummyHead->next[0] != NULL) {
+		dummyHead->next[0]->previous = tails[0];
+	}
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		if (currentLevel < other.levels) {
+			tails[currentLevel]->next[currentLevel] = dummyHead->next[currentLevel];
+			dummyHead->next[currentLevel] = other.dummyHead->next[currentLevel];
+			if (Indexed) {
+				widths(tails[currentLevel])[currentLevel] = other.count - tailRank[currentLevel] + widths(dummyHead)[currentLevel];
+				widths(dummyHead)[currentLevel] = widths(other.dummyHead)[currentLevel];
+			}
+		} else if (Indexed) {
+			widths(dummyHead)[currentLevel] += other.count;
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves the part of the height histogram and live bytes recorded for the run of Nodes
+	from the parameter Node to the end of the master level from the statistics of this list to
+	those of the other list. Does nothing, without walking the Nodes, for SLNoStats.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+void SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::handOverStats(const SLNode* first, SkipList& to) {
+	if (is_same<Stats, SLNoStats>::value) {
+		return;
+	}
+	for (const SLNode* current = first; current != NULL; current = current->next[0]) {
+		stats.deallocated(current->level, nodeSize(current->level));
+		to.stats.allocated(current->level, nodeSize(current->level));
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a new list holding every Object that is in this list, the parameter list, or
+	both. Calls combine as a helper function, so it runs in O(n + m).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::set_union(const SkipList& other) const {
+	return combine(other, true, true, true);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a new list holding every Object that is in both this list and the parameter
+	list. Calls combine as a helper function, so it runs in O(n + m).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::set_intersection(const SkipList& other) const {
+	return combine(other, false, true, false);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a new list holding every Object that is in this list but not in the parameter
+	list. Calls combine as a helper function, so it runs in O(n + m).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::set_difference(const SkipList& other) const {
+	return combine(other, true, false, false);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method walks the master levels of this list and the parameter list in lockstep and returns a
+	new list built from the Objects that are only in this list, in both lists, or only in the
+	other list, as chosen by the parameters. Each Object kept is copied in to a Node with the
+	height of the Node it came from, preferring this list's Node, and linked after the last Node
+	on every level, so the result is built in one pass with at most two comparisons per step.
+	The result uses the promotion probability, comparator, and membership filter settings of
+	this list.
+
+	POSTCONDITIONS:
+		- returns the combined list, neither list is changed
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, class Allocator, bool Indexed, class Stats, class Random>
+SkipList<Object, Compare, Allocator, Indexed, Stats, Random> SkipList<Object, Compare, Allocator, Indexed, Stats, Random>::combine(const SkipList& other,
+	bool keepOnlyThis, bool keepBoth, bool keepOnlyOther) const {
+	SkipList result(probability, compare);
+	result.filter.enableLike(filter);
+
+	SLNode* tails[MAX_LEVEL];	//last Node on each level of the result
+	int tailRank[MAX_LEVEL];
+	result.findTails(tails, tailRank);
+
+	SLNode* mine = dummyHead->next[0];
+	SLNode* theirs = other.dummyHead->next[0];
+	while (mine != NULL && theirs != NULL) {
+		if (nodeBefore(mine, theirs)) {
+			if (keepOnlyThis) {
+				result.appendNode(result.createNode(mine->data, mine->level), tails, tailRank);
+			}
+			mine = mine->next[0];
+		} else if (nodeBefore(theirs, mine)) {
+			if (keepOnlyOther) {
+				result.appendNode(result.createNode(theirs->data, theirs->level), tails, tailRank);
+			}
+			theirs = theirs->next[0];
+		} else {
+			if (keepBoth) {
+				result.appendNode(result.createNode(mine->data, mine->level), tails, tailRank);
+			}
+			mine = mine->next[0];
+			theirs = theirs->next[0];
+		}
 	}
-};
\ No newline at end of file
+
+	//copies whatever is left of the list that did not run out
+	for (; keepOnlyThis && mine != NULL; mine = mine->next[0]) {
+		result.appendNode(result.createNode(mine->data, mine->level), tails, tailRank);
+	}
+	for (; keepOnlyOther && theirs != NULL; theirs = theirs->next[0]) {
+		result.appendNode(result.createNode(theirs->data, theirs->level), tails, tailRank);
+	}
+	result.finishAppend(tails, tailRank);
+	result.rebuild_filter();
+	return result;
+};
@@ -0,0 +1,641 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing an ordered key/value map on top of the SkipList class. Every entry is a SkipMapEntry
+	holding a const Key and a Value, stored inline in one tower Node of a SkipList, and entries are ordered by their keys alone. The
+	SkipMap searches the list with the same single pass descent as SkipList, so finding, adding, and erasing an entry take O(logn).
+
+	Entries are built in place inside their Node: emplace and try_emplace forward their arguments straight to the constructors of
+	Key and Value, and insert_or_assign moves the new Value in. try_emplace and insert_or_assign search the list before anything is
+	built, so a key that is already in the map costs no allocation and no copy.
+
+	Keys are ordered by the Compare template parameter, std::less<> by default. Every lookup is a template on the type of the key it
+	is given, and any type K that the comparator can compare with Key can be used, so a map with string keys can be searched with a
+	string_view or a const char* without building a string. A comparator that caches a key prefix (see slcompare.h), such as
+	SLStringPrefixLess, is passed through to the list, so the prefix of each key is cached in its Node. find returns an iterator whose
+	second member is a reference to the stored value, and at returns the reference directly.
+
+	NOTE:	Iterators and references to entries stay valid until that entry is erased. The key of an entry can not be changed
+			through an iterator since that could break the order of the map.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef skipmap_h
+#define skipmap_h
+
+//imports libraries
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <functional>
+#include "skiplist.h"
+#include "slcompare.h"
+
+using namespace std;
+
+//one key/value entry of a SkipMap, compared by its key alone
+template<class Key, class Value>
+struct SkipMapEntry {
+
+	const Key first;	//key of the entry
+	Value second;		//value of the entry
+
+	//builds the key from k and the value from the rest of the arguments
+	template<class K, class... Args, typename enable_if<!is_same<typename decay<K>::type, SkipMapEntry>::value, int>::type = 0>
+	explicit SkipMapEntry(K&& k, Args&&... args) : first(std::forward<K>(k)), second(std::forward<Args>(args)...) {};
+};
+
+//orders SkipMap entries by their keys with the key comparator of the map. An entry can be
+//compared with another entry or with any key type the key comparator accepts
+template<class Key, class Value, class Compare>
+struct SkipMapCompare {
+
+	typedef SkipMapEntry<Key, Value> Entry;
+
+	SkipMapCompare(const Compare& comp = Compare()) : keyCompare(comp) {};
+	bool operator()(const Entry& a, const Entry& b) const { return keyCompare(a.first, b.first); };
+	template<class K>
+	bool operator()(const Entry& a, const K& k) const { return keyCompare(a.first, k); };
+	template<class K>
+	bool operator()(const K& k, const Entry& a) const { return keyCompare(k, a.first); };
+
+	Compare keyCompare;		//comparator the map was given for its keys
+};
+
+//SkipMapCompare for key comparators that cache a prefix, passes the prefix of the key through
+template<class Key, class Value, class Compare>
+struct SkipMapPrefixCompare : SkipMapCompare<Key, Value, Compare> {
+
+	typedef SkipMapEntry<Key, Value> Entry;
+	typedef typename Compare::prefix_type prefix_type;
+
+	SkipMapPrefixCompare(const Compare& comp = Compare()) : SkipMapCompare<Key, Value, Compare>(comp) {};
+	prefix_type prefix(const Entry& e) const { return this->keyCompare.prefix(e.first); };
+	template<class K>
+	prefix_type prefix(const K& k) const { return this->keyCompare.prefix(k); };
+};
+
+template<class Key, class Value, class Compare = less<>, class Allocator = SLPoolAllocator, class Stats = SLNoStats>
+
+class SkipMap {
+
+	private:
+
+	typedef SkipMapEntry<Key, Value> Entry;
+	typedef typename conditional<SLCompareTraits<Compare>::hasPrefix, SkipMapPrefixCompare<Key, Value, Compare>,
+		SkipMapCompare<Key, Value, Compare> >::type EntryCompare;
+	typedef SkipList<Entry, EntryCompare, Allocator, false, Stats> List;
+	typedef typename List::SLNode SLNode;
+
+	//bidirectional iterator over the entries of the map, in order of their keys.
+	//IsConst picks between iterator and const_iterator
+	template<bool IsConst>
+	class basic_iterator {
+
+		public:
+
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef Entry value_type;
+		typedef ptrdiff_t difference_type;
+		typedef typename conditional<IsConst, const Entry*, Entry*>::type pointer;
+		typedef typename conditional<IsConst, const Entry&, Entry&>::type reference;
+
+		basic_iterator(void) : node(NULL), map(NULL) {};
+		template<bool WasConst, typename enable_if<IsConst && !WasConst, int>::type = 0>
+		basic_iterator(const basic_iterator<WasConst>& other) : node(other.node), map(other.map) {};
+		reference operator*(void) const { return node->data; };
+		pointer operator->(void) const { return &node->data; };
+		basic_iterator& operator++(void) { node = node->next[0]; return *this; };
+		basic_iterator operator++(int) { basic_iterator old = *this; ++*this; return old; };
+		basic_iterator& operator--(void) { node = (node == NULL) ? map->list.lastNode() : node->previous; return *this; };
+		basic_iterator operator--(int) { basic_iterator old = *this; --*this; return old; };
+		bool operator==(const basic_iterator& other) const { return node == other.node; };
+		bool operator!=(const basic_iterator& other) const { return node != other.node; };
+
+		private:
+
+		friend class SkipMap;
+		basic_iterator(SLNode* n, const SkipMap* m) : node(n), map(m) {};
+
+		SLNode* node;			//Node the iterator is on, NULL past the last Node
+		const SkipMap* map;		//map being iterated, used to step back from the end
+	};
+
+	public:
+
+	typedef Key key_type;
+	typedef Value mapped_type;
+	typedef Entry value_type;
+	typedef basic_iterator<false> iterator;
+	typedef basic_iterator<true> const_iterator;
+
+	SkipMap(void);										//Default no-args contructor
+	explicit SkipMap(double promotion, const Compare& comp = Compare());	//constructor taking the promotion probability
+	SkipMap(const SkipMap& toCopy) = default;			//Copy constructor, copies every entry
+	SkipMap(SkipMap&& toMove) = default;				//Move constructor, takes over the entries of toMove
+	SkipMap& operator=(const SkipMap& toCopy) = default;	//copies every entry
+	SkipMap& operator=(SkipMap&& toMove) = default;		//takes over the entries of toMove in O(1)
+	int size(void) const;								//returns the number of entries
+	bool isEmpty(void) const;							//returns bool indicating if there are any entries
+	void makeEmpty(void);								//erases every entry
+	int getCost(void) const;							//returns the number of comparisons made
+	const Stats& getStats(void) const;					//returns the statistics recorded by the map
+	Stats& getStats(void);								//returns the statistics recorded by the map
+	bool operator==(const SkipMap& toCompare) const;	//true if both maps hold equal keys with equal values
+	template<class K>
+	bool contains(const K& key) const;					//returns true if an entry has the key
+	template<class K>
+	iterator find(const K& key);						//returns an iterator to the entry with the key, or end()
+	template<class K>
+	const_iterator find(const K& key) const;			//returns an iterator to the entry with the key, or end()
+	template<class K>
+	Value& at(const K& key);							//returns the value of the entry with the key
+	template<class K>
+	const Value& at(const K& key) const;				//returns the value of the entry with the key
+	Value& operator[](const Key& key);					//returns the value for the key, adding a default value if needed
+	Value& operator[](Key&& key);						//returns the value for the key, adding a default value if needed
+	template<class... Args>
+	pair<iterator, bool> emplace(Args&&... args);		//adds an entry built from a key and value arguments
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const Key& key, Args&&... args);	//adds an entry only if the key is missing
+	template<class... Args>
+	pair<iterator, bool> try_emplace(Key&& key, Args&&... args);		//adds an entry only if the key is missing
+	template<class M>
+	pair<iterator, bool> insert_or_assign(const Key& key, M&& value);	//adds an entry or replaces its value
+	template<class M>
+	pair<iterator, bool> insert_or_assign(Key&& key, M&& value);		//adds an entry or replaces its value
+	template<class K>
+	bool erase(const K& key);							//erases the entry with the key
+	iterator begin(void);								//returns an iterator to the smallest key
+	iterator end(void);									//returns an iterator past the largest key
+	const_iterator begin(void) const;					//returns an iterator to the smallest key
+	const_iterator end(void) const;						//returns an iterator past the largest key
+	template<class K>
+	iterator lower_bound(const K& key);					//returns an iterator to the first key not less than key
+	template<class K>
+	iterator upper_bound(const K& key);					//returns an iterator to the first key greater than key
+
+	private:
+
+	template<class K>
+	SLNode* findNode(const K& key) const;				//returns the Node with the key, or NULL
+	template<class K, class... Args>
+	pair<iterator, bool> tryEmplace(K&& key, Args&&... args);	//adds an entry only if the key is missing
+	template<class K, class M>
+	pair<iterator, bool> insertOrAssign(K&& key, M&& value);	//adds an entry or replaces its value
+
+	List list;							//list of entries ordered by key
+};
+
+#endif // !skipmap_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty map with a promotion probability of 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+SkipMap<Key, Value, Compare, Allocator, Stats>::SkipMap(void) {
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty map whose list promotes Nodes with a chance equal to the
+	parameter and orders keys with the parameter comparator.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+SkipMap<Key, Value, Compare, Allocator, Stats>::SkipMap(double promotion, const Compare& comp) : list(promotion, EntryCompare(comp)) {
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of entries in the map.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+int SkipMap<Key, Value, Compare, Allocator, Stats>::size(void) const {
+	return list.size();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a bool indicating if the map has no entries.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+bool SkipMap<Key, Value, Compare, Allocator, Stats>::isEmpty(void) const {
+	return list.isEmpty();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method erases every entry and deallocates their Nodes.
+
+	POSTCONDITIONS:
+		- the map is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+void SkipMap<Key, Value, Compare, Allocator, Stats>::makeEmpty(void) {
+	list.makeEmpty();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of key comparisons recorded by the statistics policy of the map,
+	0 with the default SLNoStats.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+int SkipMap<Key, Value, Compare, Allocator, Stats>::getCost(void) const {
+	return list.getCost();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the statistics recorded by the list that holds the entries (see slstats.h).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+const Stats& SkipMap<Key, Value, Compare, Allocator, Stats>::getStats(void) const {
+	return list.getStats();
+};
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+Stats& SkipMap<Key, Value, Compare, Allocator, Stats>::getStats(void) {
+	return list.getStats();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded operator equals. Walks both maps in order and returns false at the first entry
+	whose key or value differs. Value must have an overloaded equality operator.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+bool SkipMap<Key, Value, Compare, Allocator, Stats>::operator==(const SkipMap& toCompare) const {
+	if (size() != toCompare.size()) {
+		return false;
+	}
+	const_iterator other = toCompare.begin();
+	for (const_iterator current = begin(); current != end(); ++current, ++other) {
+		if (list.compare(*current, *other) || list.compare(*other, *current) || !(current->second == other->second)) {
+			return false;
+		}
+	}
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if an entry has a key equal to the parameter key.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+bool SkipMap<Key, Value, Compare, Allocator, Stats>::contains(const K& key) const {
+	return findNode(key) != NULL;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the entry whose key is equal to the parameter key, or end() if
+	there is none. The value of the entry can be read and changed through the iterator.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator SkipMap<Key, Value, Compare, Allocator, Stats>::find(const K& key) {
+	return iterator(findNode(key), this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the entry whose key is equal to the parameter key, or end() if
+	there is none. Method cannot change any entries.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::const_iterator SkipMap<Key, Value, Compare, Allocator, Stats>::find(const K& key) const {
+	return const_iterator(findNode(key), this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a reference to the value of the entry whose key is equal to the parameter key.
+	Throws out_of_range if there is no such entry.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+Value& SkipMap<Key, Value, Compare, Allocator, Stats>::at(const K& key) {
+	SLNode* node = findNode(key);
+	if (node == NULL) {
+		throw out_of_range("SkipMap::at: key not in map");
+	}
+	return node->data.second;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a reference to the value of the entry whose key is equal to the parameter key.
+	Throws out_of_range if there is no such entry. Method cannot change any entries.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+const Value& SkipMap<Key, Value, Compare, Allocator, Stats>::at(const K& key) const {
+	SLNode* node = findNode(key);
+	if (node == NULL) {
+		throw out_of_range("SkipMap::at: key not in map");
+	}
+	return node->data.second;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded subscript operator. Returns a reference to the value of the entry with the key,
+	adding an entry with a default constructed value if the key is missing.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+Value& SkipMap<Key, Value, Compare, Allocator, Stats>::operator[](const Key& key) {
+	return tryEmplace(key).first->second;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded subscript operator. Returns a reference to the value of the entry with the key,
+	moving the key in to a new entry with a default constructed value if the key is missing.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+Value& SkipMap<Key, Value, Compare, Allocator, Stats>::operator[](Key&& key) {
+	return tryEmplace(std::move(key)).first->second;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method builds an entry inside a new Node, the key from the first argument and the value from
+	the rest, and adds it to the map. The entry has to exist before the map can be searched for
+	its key, so if the key is already in the map the new Node is deleted. Use try_emplace to
+	avoid building the entry when the key may already be in the map.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class... Args>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::emplace(Args&&... args) {
+	SLNode* newNode = list.emplaceNode(list.randomLevel(), std::forward<Args>(args)...);
+
+	SLNode* update[List::MAX_LEVEL];	//last Node before the new entry on each level
+	int rank[List::MAX_LEVEL];
+	SLNode* nodeAfter = list.findPredecessors(newNode->data.first, update, rank);
+
+	if (list.isMatch(nodeAfter, newNode->data.first)) {	//checks if the key is already in the map
+		list.deleteNode(newNode);
+		return make_pair(iterator(nodeAfter, this), false);
+	}
+
+	list.linkNode(newNode, update, rank);
+	return make_pair(iterator(newNode, this), true);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds an entry with the parameter key and a value built from the rest of the arguments
+	if the key is not already in the map. Nothing is built or moved from when the key is found.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class... Args>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::try_emplace(const Key& key, Args&&... args) {
+	return tryEmplace(key, std::forward<Args>(args)...);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds an entry with the parameter key, moved in to the entry, and a value built from
+	the rest of the arguments if the key is not already in the map. Nothing is built or moved
+	from when the key is found.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class... Args>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::try_emplace(Key&& key, Args&&... args) {
+	return tryEmplace(std::move(key), std::forward<Args>(args)...);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds an entry with the parameter key and value if the key is not already in the map,
+	otherwise assigns the parameter value to the entry that has the key.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class M>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::insert_or_assign(const Key& key, M&& value) {
+	return insertOrAssign(key, std::forward<M>(value));
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds an entry with the parameter key, moved in to the entry, and value if the key is
+	not already in the map, otherwise assigns the parameter value to the entry that has the key.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class M>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::insert_or_assign(Key&& key, M&& value) {
+	return insertOrAssign(std::move(key), std::forward<M>(value));
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method erases the entry whose key is equal to the parameter key. The list is searched once,
+	recording the Node before the entry on every level, and the Node is unlinked and deleted.
+
+	POSTCONDITIONS:
+		- no entry has the key
+		- returns true if an entry was erased
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+bool SkipMap<Key, Value, Compare, Allocator, Stats>::erase(const K& key) {
+	SLNode* update[List::MAX_LEVEL];
+	SLNode* toDelete = list.findPredecessors(key, update);
+	if (!list.isMatch(toDelete, key)) {
+		return false;
+	}
+	list.unlinkNode(toDelete, update);
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Methods return iterators to the entry with the smallest key and past the entry with the
+	largest key.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator SkipMap<Key, Value, Compare, Allocator, Stats>::begin(void) {
+	return iterator(list.dummyHead->next[0], this);
+};
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator SkipMap<Key, Value, Compare, Allocator, Stats>::end(void) {
+	return iterator(NULL, this);
+};
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::const_iterator SkipMap<Key, Value, Compare, Allocator, Stats>::begin(void) const {
+	return const_iterator(list.dummyHead->next[0], this);
+};
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::const_iterator SkipMap<Key, Value, Compare, Allocator, Stats>::end(void) const {
+	return const_iterator(NULL, this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first entry whose key is not less than the parameter key,
+	or end() if there is none.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator SkipMap<Key, Value, Compare, Allocator, Stats>::lower_bound(const K& key) {
+	SLNode* update[List::MAX_LEVEL];
+	return iterator(list.findPredecessors(key, update), this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first entry whose key is greater than the parameter key,
+	or end() if there is none.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator SkipMap<Key, Value, Compare, Allocator, Stats>::upper_bound(const K& key) {
+	return iterator(list.findGreater(key), this);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method searches the list for the parameter key with one comparison per Node visited and
+	returns the Node of the entry with that key, or NULL if there is none.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K>
+typename SkipMap<Key, Value, Compare, Allocator, Stats>::SLNode* SkipMap<Key, Value, Compare, Allocator, Stats>::findNode(const K& key) const {
+	SLNode* update[List::MAX_LEVEL];
+	SLNode* nodeAfter = list.findPredecessors(key, update);
+	return list.isMatch(nodeAfter, key) ? nodeAfter : NULL;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method searches the list for the parameter key once, recording the Node before it on every
+	level. If the key is missing a new Node is built in place from the key and the rest of the
+	arguments and sewn in after the recorded Nodes.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K, class... Args>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::tryEmplace(K&& key, Args&&... args) {
+	SLNode* update[List::MAX_LEVEL];	//last Node before the key on each level
+	int rank[List::MAX_LEVEL];
+	SLNode* nodeAfter = list.findPredecessors(key, update, rank);
+
+	if (list.isMatch(nodeAfter, key)) {	//checks if the key is already in the map
+		return make_pair(iterator(nodeAfter, this), false);
+	}
+
+	SLNode* newNode = list.emplaceNode(list.randomLevel(), std::forward<K>(key), std::forward<Args>(args)...);
+	list.linkNode(newNode, update, rank);
+	return make_pair(iterator(newNode, this), true);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method searches the list for the parameter key once. If the key is found the parameter value
+	is assigned to its entry, otherwise a new entry is built in place from the key and value and
+	sewn in after the Nodes recorded by the search.
+
+	POSTCONDITIONS:
+		- returns an iterator to the entry with the key, and true if the entry was added
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Key, class Value, class Compare, class Allocator, class Stats>
+template<class K, class M>
+pair<typename SkipMap<Key, Value, Compare, Allocator, Stats>::iterator, bool> SkipMap<Key, Value, Compare, Allocator, Stats>::insertOrAssign(K&& key, M&& value) {
+	SLNode* update[List::MAX_LEVEL];	//last Node before the key on each level
+	int rank[List::MAX_LEVEL];
+	SLNode* nodeAfter = list.findPredecessors(key, update, rank);
+
+	if (list.isMatch(nodeAfter, key)) {	//checks if the key is already in the map
+		nodeAfter->data.second = std::forward<M>(value);
+		return make_pair(iterator(nodeAfter, this), false);
+	}
+
+	SLNode* newNode = list.emplaceNode(list.randomLevel(), std::forward<K>(key), std::forward<M>(value));
+	list.linkNode(newNode, update, rank);
+	return make_pair(iterator(newNode, this), true);
+};
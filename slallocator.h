@@ -0,0 +1,352 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Node allocators for the SkipList class. An allocator hands out raw, untyped blocks of memory for Nodes; the SkipList constructs
+	and destroys the Objects inside of them. Every allocator provides:
+
+		void* allocate(size_t bytes)				returns a block of at least bytes bytes
+		void deallocate(void* block, size_t bytes)	returns a block, bytes is the same value it was allocated with
+		bool release(void)							frees every block handed out at once, returns false if not supported
+		void absorb(Allocator& other)				takes over every block handed out by other, so they can be deallocated
+													through this allocator and outlive other
+		void share(Allocator& other)				becomes a co-owner of every block handed out by other, so blocks moved
+													from other can be deallocated through this allocator and stay valid
+													until both allocators are released
+		static const bool bulkRelease				true if release is supported
+
+	SLPoolAllocator is the default allocator. Blocks are grouped in to size classes that are a multiple of GRANULE bytes wide. Each
+	size class carves its blocks out of large contiguous slabs, and blocks that are deallocated are kept on a free list for the size
+	class so that they can be handed out again without calling the global allocator. release drops every slab at once, so a list
+	of trivially destructible Objects can be emptied without walking it. Copying a SLPoolAllocator creates a new, empty pool. absorb
+	moves the slabs and free blocks of another pool in to this one, which lets one list take over the Nodes of another.
+
+	Slabs are kept in slab sets that are reference counted, and a set is freed when the last pool holding it is released. share
+	makes a pool hold the slab sets of another pool, which lets a list hand some of its Nodes to another list (SkipList::split)
+	without copying them: the memory of the moved Nodes stays valid as long as either list still holds it.
+
+	SLHeapAllocator sends every request to the global operator new and operator delete.
+
+	NOTE:	Neither allocator is thread safe.
+
+	NOTE:	Blocks handed out by SLPoolAllocator are aligned to the largest power of two that divides the size class, up to the
+			alignment of max_align_t. The SkipList rounds Node sizes up to the alignment of a Node.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slallocator_h
+#define slallocator_h
+
+//imports libraries
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+class SLPoolAllocator {
+
+	private:
+
+	struct SLFreeBlock {
+		SLFreeBlock* next;	//next free block in the same size class
+	};
+
+	struct SLSizeClass {
+		SLFreeBlock* freeList;	//blocks that have been deallocated
+		char* cursor;			//next unused block in the newest slab
+		char* end;				//end of the newest slab
+		size_t slabBlocks;		//number of blocks in the newest slab
+
+		SLSizeClass() : freeList(NULL), cursor(NULL), end(NULL), slabBlocks(0) {};
+	};
+
+	struct SLSlabSet {
+		vector<void*> slabs;	//slabs freed together once no pool holds the set
+
+		~SLSlabSet() {
+			for (size_t i = 0; i < slabs.size(); i++) {
+				::operator delete(slabs[i]);
+			}
+		};
+	};
+
+	public:
+
+	static const bool bulkRelease = true;
+	static const size_t GRANULE = sizeof(void*);	//size classes are a multiple of this many bytes
+	static const size_t MIN_SLAB_BLOCKS = 16;		//number of blocks in the first slab of a size class
+	static const size_t SLAB_BYTES = 64 * 1024;		//slabs stop doubling once they reach this size
+
+	SLPoolAllocator(void);								//Default no-args constructor
+	SLPoolAllocator(const SLPoolAllocator& toCopy);		//Copy constructor, creates an empty pool
+	~SLPoolAllocator(void);								//Destructor
+	SLPoolAllocator& operator=(const SLPoolAllocator& toCopy);	//keeps this pool
+	void* allocate(size_t bytes);						//returns a block of at least bytes bytes
+	void deallocate(void* block, size_t bytes);			//returns a block to its size class
+	bool release(void);									//frees every slab
+	void absorb(SLPoolAllocator& other);				//takes over the slabs of another pool
+	void share(SLPoolAllocator& other);					//holds the slabs of another pool along with it
+	size_t bytesReserved(void) const;					//returns the number of bytes held in slabs
+
+	private:
+
+	void addSlab(SLSizeClass& sizeClass, size_t blockBytes);	//gives a size class a new slab
+	void hold(const shared_ptr<SLSlabSet>& set);		//keeps a slab set of another pool alive
+
+	vector<SLSizeClass> sizeClasses;	//size classes indexed by block size / GRANULE
+	shared_ptr<SLSlabSet> slabs;		//slabs allocated by the pool, NULL until the first one
+	vector<shared_ptr<SLSlabSet> > held;	//slab sets of other pools that blocks of the pool may come from
+	size_t reserved;					//total bytes in slabs allocated or absorbed by the pool
+};
+
+class SLHeapAllocator {
+
+	public:
+
+	static const bool bulkRelease = false;
+
+	void* allocate(size_t bytes) { return ::operator new(bytes); };
+	void deallocate(void* block, size_t) { ::operator delete(block); };
+	bool release(void) { return false; };
+	void absorb(SLHeapAllocator&) {};
+	void share(SLHeapAllocator&) {};
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty pool. No slabs are allocated until the first block is
+	requested.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline SLPoolAllocator::SLPoolAllocator(void) : reserved(0) {
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Copy-constructor. Blocks can not be shared between pools, so the copy starts out as an empty
+	pool of its own.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline SLPoolAllocator::SLPoolAllocator(const SLPoolAllocator&) : reserved(0) {
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. Frees every slab owned by the pool.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline SLPoolAllocator::~SLPoolAllocator(void) {
+	release();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded assignment operator. Blocks already handed out by this pool must stay valid, so
+	the pool is left unchanged.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline SLPoolAllocator& SLPoolAllocator::operator=(const SLPoolAllocator&) {
+	return *this;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a block of at least bytes bytes. The block is taken from the free list of its
+	size class if one is available, otherwise it is carved from the newest slab of the size
+	class, and a new slab is allocated when that slab is used up.
+
+	POSTCONDITIONS:
+		- returns a pointer to an unused block
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void* SLPoolAllocator::allocate(size_t bytes) {
+	size_t index = (bytes + GRANULE - 1) / GRANULE;		//size class of the block
+	size_t blockBytes = index * GRANULE;
+
+	if (index >= sizeClasses.size()) {
+		sizeClasses.resize(index + 1);
+	}
+	SLSizeClass& sizeClass = sizeClasses[index];
+
+	if (sizeClass.freeList != NULL) {		//reuses a deallocated block
+		SLFreeBlock* block = sizeClass.freeList;
+		sizeClass.freeList = block->next;
+		return block;
+	}
+	if (sizeClass.cursor == sizeClass.end) {	//the newest slab is used up
+		addSlab(sizeClass, blockBytes);
+	}
+	void* block = sizeClass.cursor;
+	sizeClass.cursor += blockBytes;
+	return block;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns a block to the free list of its size class. The memory stays in the slab until
+	release is called. A block shared from another pool may belong to a size class this pool has
+	not used yet.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLPoolAllocator::deallocate(void* block, size_t bytes) {
+	size_t index = (bytes + GRANULE - 1) / GRANULE;
+	if (index >= sizeClasses.size()) {
+		sizeClasses.resize(index + 1);
+	}
+	SLFreeBlock* freed = static_cast<SLFreeBlock*>(block);
+	freed->next = sizeClasses[index].freeList;
+	sizeClasses[index].freeList = freed;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method drops every slab set held by the pool, which frees each set in one pass over its slab
+	list unless another pool still holds it. Every block handed out by the pool becomes invalid
+	to the pool.
+
+	POSTCONDITIONS:
+		- the pool owns no memory
+		- returns true
+
+-------------------------------------------------------------------------------------------------*/
+
+inline bool SLPoolAllocator::release(void) {
+	slabs.reset();
+	held.clear();
+	sizeClasses.clear();
+	reserved = 0;
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method takes over every slab of the parameter pool, along with its free blocks, so blocks
+	handed out by the other pool can be deallocated through this pool and stay valid after the
+	other pool is released or destroyed. The unused end of the newest slab of each size class of
+	the other pool is not reused.
+
+	POSTCONDITIONS:
+		- this pool owns every slab the other pool owned
+		- the other pool owns no memory
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLPoolAllocator::absorb(SLPoolAllocator& other) {
+	if (&other == this) {
+		return;
+	}
+	if (sizeClasses.size() < other.sizeClasses.size()) {
+		sizeClasses.resize(other.sizeClasses.size());
+	}
+	for (size_t index = 0; index < other.sizeClasses.size(); index++) {
+		SLFreeBlock* freed = other.sizeClasses[index].freeList;
+		while (freed != NULL) {		//moves the free blocks of the other pool to this pool
+			SLFreeBlock* next = freed->next;
+			freed->next = sizeClasses[index].freeList;
+			sizeClasses[index].freeList = freed;
+			freed = next;
+		}
+	}
+	hold(other.slabs);
+	for (size_t i = 0; i < other.held.size(); i++) {
+		hold(other.held[i]);
+	}
+	reserved += other.reserved;
+	other.slabs.reset();
+	other.held.clear();
+	other.sizeClasses.clear();
+	other.reserved = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method makes this pool hold every slab set of the parameter pool, so blocks handed out by the
+	other pool can be moved to this pool and deallocated through it. The slabs stay valid until
+	both pools are released. Free blocks of the other pool stay with the other pool, and the
+	bytes of the shared slabs are only counted by the other pool.
+
+	POSTCONDITIONS:
+		- this pool holds every slab set the other pool holds
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLPoolAllocator::share(SLPoolAllocator& other) {
+	if (&other == this) {
+		return;
+	}
+	hold(other.slabs);
+	for (size_t i = 0; i < other.held.size(); i++) {
+		hold(other.held[i]);
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of bytes held in slabs, including blocks that are free.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline size_t SLPoolAllocator::bytesReserved(void) const {
+	return reserved;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method allocates a new slab for the size class. The first slab holds MIN_SLAB_BLOCKS blocks
+	and each slab after it is twice as large as the one before, until slabs reach SLAB_BYTES, so
+	that small lists do not reserve large slabs.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLPoolAllocator::addSlab(SLSizeClass& sizeClass, size_t blockBytes) {
+	size_t blocks = MIN_SLAB_BLOCKS;
+	if (sizeClass.slabBlocks != 0) {
+		blocks = sizeClass.slabBlocks;
+		if (blocks * blockBytes < SLAB_BYTES) {
+			blocks *= 2;
+		}
+	}
+	sizeClass.slabBlocks = blocks;
+	size_t slabBytes = blocks * blockBytes;
+	char* slab = static_cast<char*>(::operator new(slabBytes));
+	if (!slabs) {
+		slabs = make_shared<SLSlabSet>();
+	}
+	slabs->slabs.push_back(slab);
+	reserved += slabBytes;
+	sizeClass.cursor = slab;
+	sizeClass.end = slab + slabBytes;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds a slab set of another pool to the sets the pool holds, unless it is NULL, the
+	pool's own set, or already held.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLPoolAllocator::hold(const shared_ptr<SLSlabSet>& set) {
+	if (!set || set == slabs) {
+		return;
+	}
+	for (size_t i = 0; i < held.size(); i++) {
+		if (held[i] == set) {
+			return;
+		}
+	}
+	held.push_back(set);
+};
+
+#endif // !slallocator_h
@@ -0,0 +1,89 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Comparators for the SkipList class. A SkipList orders its Objects with the Compare template parameter, a strict weak ordering
+	called as compare(a, b) that returns true if a comes before b. std::less<Object> is the default. Searches call it once for every
+	Node they visit, and decide equality at the end of a search with one more call.
+
+	A comparator can also give every Object a fixed-width prefix that the SkipList caches inside each Node, by providing:
+
+		typedef ... prefix_type						an unsigned integer type
+		prefix_type prefix(const T& t) const		the prefix of t, for every type T the comparator accepts
+
+	The prefix has to agree with the ordering: if prefix(a) < prefix(b) then a comes before b. Two Objects with equal prefixes may
+	still differ. A search compares the cached prefix of a Node with the prefix of the target first and only calls the comparator on
+	the full Objects when the prefixes are equal, so most Nodes are passed over without reading the Object at all.
+
+	SLStringPrefixLess orders strings and caches their first eight bytes, read big-endian so that comparing prefixes as integers
+	matches comparing the bytes. It is transparent, so a list of strings can be searched with a string_view or a const char*.
+
+	SLCompareTraits tells the SkipList whether a comparator provides a prefix. Comparators that do not get the empty SLNoPrefix,
+	which takes no space in a Node.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slcompare_h
+#define slcompare_h
+
+//imports libraries
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+using namespace std;
+
+//prefix of comparators that do not provide one
+struct SLNoPrefix {};
+
+template<class Compare, class = void>
+struct SLCompareTraits {
+	static const bool hasPrefix = false;
+	typedef SLNoPrefix prefix_type;
+
+	template<class T>
+	static SLNoPrefix prefix(const Compare&, const T&) { return SLNoPrefix(); };
+};
+
+template<class Compare>
+struct SLCompareTraits<Compare, void_t<typename Compare::prefix_type> > {
+	static const bool hasPrefix = true;
+	typedef typename Compare::prefix_type prefix_type;
+
+	template<class T>
+	static prefix_type prefix(const Compare& compare, const T& t) { return compare.prefix(t); };
+};
+
+//prefix cached at the start of a Node, empty for comparators without a prefix
+template<class Prefix>
+struct SLPrefixField {
+	Prefix prefix;		//prefix of the Object in the Node
+};
+
+template<>
+struct SLPrefixField<SLNoPrefix> {
+};
+
+//orders strings byte by byte and caches their first eight bytes
+struct SLStringPrefixLess {
+
+	typedef uint64_t prefix_type;
+	typedef void is_transparent;
+
+	bool operator()(string_view a, string_view b) const { return a < b; };
+
+	prefix_type prefix(string_view s) const {
+		prefix_type p = 0;
+		for (size_t i = 0; i < 8; i++) {		//strings shorter than eight bytes are padded with zeros
+			p = (p << 8) | (i < s.size() ? (unsigned char)s[i] : 0);
+		}
+		return p;
+	};
+};
+
+#endif // !slcompare_h
@@ -0,0 +1,244 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Epoch based memory reclamation for the concurrent skip lists. A Node that has been unlinked from a list can not be deallocated
+	right away because another thread may still be reading it. Instead it is retired in to the limbo list of the current global epoch.
+	Every thread that reads a list first enters the reclaimer by publishing the global epoch it observed in a slot, and leaves it when
+	the operation is done. The global epoch can only advance when every thread inside the reclaimer has observed the current epoch. Once
+	the epoch has advanced twice past the epoch a Node was retired in, no thread can still hold a pointer to it and it is deallocated.
+
+	Nothing in the reclaimer takes a lock. Each slot has its own limbo lists, one per epoch, that only the thread holding the slot
+	touches, so retire claims a slot like enter does, adds the block to the list of that slot, and frees the lists of the slot that
+	are two epochs old. The global epoch is advanced with a compare and swap by whichever thread sees that every other thread has
+	caught up, and a thread that is preempted at any point only holds back the epoch, never another thread's retire or free. Blocks
+	left in the lists of a slot that is not used again are deallocated with the reclaimer.
+
+	Threads hold a slot only for the length of one operation, and a second one while they retire a block, so any number of threads can
+	use a reclaimer as long as no more than SLOTS / 2 of them are inside it at the same time. Use SLEpochGuard to enter and leave a reclaimer.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slepoch_h
+#define slepoch_h
+
+//imports libraries
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class SLEpochReclaimer {
+
+	private:
+
+	struct SLRetired {
+		void* block;				//memory to deallocate
+		void (*destroy)(void*);		//function that deallocates it
+	};
+
+	struct alignas(64) SLSlot {
+		atomic<bool> inUse;				//true while a thread holds the slot
+		atomic<unsigned long> epoch;	//global epoch observed by the thread holding the slot
+		vector<SLRetired> limbo[3];		//blocks retired through the slot, by epoch mod 3, only touched by its holder
+		unsigned long limboEpoch[3];	//epoch the blocks in each limbo list were retired in
+		size_t sinceAdvance;			//blocks retired through the slot since its last attempt to advance
+
+		SLSlot() : inUse(false), epoch(0), limboEpoch(), sinceAdvance(0) {};
+	};
+
+	public:
+
+	static const int SLOTS = 128;			//most threads that can be inside the reclaimer at once
+	static const size_t ADVANCE_EVERY = 64;	//blocks retired through a slot between attempts to advance the epoch
+
+	SLEpochReclaimer(void);					//Default no-args constructor
+	~SLEpochReclaimer(void);				//Destructor, deallocates every retired block
+	int enter(void);						//claims a slot and publishes the global epoch
+	void leave(int slot);					//gives a slot back
+	void retire(void* block, void (*destroy)(void*));	//deallocates block once no thread can reach it
+
+	private:
+
+	SLEpochReclaimer(const SLEpochReclaimer&);				//not copyable
+	SLEpochReclaimer& operator=(const SLEpochReclaimer&);	//not copyable
+	bool tryAdvance(void);					//advances the epoch if every thread has observed it
+	void freeExpired(SLSlot& slot, unsigned long epoch);	//deallocates the limbo lists of a slot two epochs old
+	void freeLimbo(vector<SLRetired>& limbo);	//deallocates a limbo list
+
+	atomic<unsigned long> globalEpoch;		//current global epoch
+	SLSlot slots[SLOTS];					//one slot per thread inside the reclaimer
+};
+
+//claims a slot of a reclaimer for the lifetime of the guard
+class SLEpochGuard {
+
+	public:
+
+	explicit SLEpochGuard(SLEpochReclaimer& r) : reclaimer(r), slot(r.enter()) {};
+	~SLEpochGuard(void) { reclaimer.leave(slot); };
+
+	private:
+
+	SLEpochGuard(const SLEpochGuard&);				//not copyable
+	SLEpochGuard& operator=(const SLEpochGuard&);	//not copyable
+
+	SLEpochReclaimer& reclaimer;
+	int slot;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates a reclaimer with every slot free and empty limbo lists.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline SLEpochReclaimer::SLEpochReclaimer(void) : globalEpoch(0) {
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. No thread may be inside the reclaimer, so every retired block is deallocated.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline SLEpochReclaimer::~SLEpochReclaimer(void) {
+	for (int slot = 0; slot < SLOTS; slot++) {
+		for (int i = 0; i < 3; i++) {
+			freeLimbo(slots[slot].limbo[i]);
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method claims a free slot, starting the scan at a slot picked from the thread id so that
+	threads rarely collide, and publishes the global epoch in it. The epoch is published again
+	if the global epoch moved while it was being published, so a thread never holds a stale
+	epoch that another thread has already advanced past.
+
+	POSTCONDITIONS:
+		- returns the index of the claimed slot
+
+-------------------------------------------------------------------------------------------------*/
+
+inline int SLEpochReclaimer::enter(void) {
+	int slot = (int)(hash<thread::id>()(this_thread::get_id()) % SLOTS);
+	while (true) {
+		bool expected = false;
+		if (!slots[slot].inUse.load(memory_order_relaxed)
+			&& slots[slot].inUse.compare_exchange_strong(expected, true)) {
+			break;
+		}
+		slot = (slot + 1) % SLOTS;
+	}
+
+	unsigned long epoch = globalEpoch.load();
+	while (true) {
+		slots[slot].epoch.store(epoch);
+		unsigned long current = globalEpoch.load();
+		if (current == epoch) {
+			break;
+		}
+		epoch = current;
+	}
+	return slot;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method gives back a slot claimed by enter. The thread must not use any pointer it read from
+	a list after leaving.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLEpochReclaimer::leave(int slot) {
+	slots[slot].inUse.store(false, memory_order_release);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method adds a block that can no longer be reached from a list to the limbo list of the
+	current epoch in a slot it claims for the call, so no other thread touches the list. Every
+	ADVANCE_EVERY blocks retired through the slot the epoch is advanced if possible. The limbo
+	lists of the slot that are two epochs old are then deallocated by this thread, outside of
+	any lock.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLEpochReclaimer::retire(void* block, void (*destroy)(void*)) {
+	int claimed = enter();
+	SLSlot& slot = slots[claimed];
+	unsigned long epoch = globalEpoch.load();
+	freeExpired(slot, epoch);		//empties the list of epoch - 3 that shares an index with epoch
+
+	SLRetired retired = { block, destroy };
+	slot.limbo[epoch % 3].push_back(retired);
+	slot.limboEpoch[epoch % 3] = epoch;
+	if (++slot.sinceAdvance >= ADVANCE_EVERY) {
+		slot.sinceAdvance = 0;
+		if (tryAdvance()) {
+			freeExpired(slot, globalEpoch.load());
+		}
+	}
+	leave(claimed);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method advances the global epoch from e to e + 1 with a compare and swap if every thread
+	inside the reclaimer has observed e. Every thread that could have read a block retired in
+	e - 1 has then left, so those blocks can be deallocated by the slots holding them. If another
+	thread advanced the epoch first the compare and swap fails and nothing changes.
+
+	POSTCONDITIONS:
+		- returns true if the epoch advanced
+
+-------------------------------------------------------------------------------------------------*/
+
+inline bool SLEpochReclaimer::tryAdvance(void) {
+	unsigned long epoch = globalEpoch.load();
+	for (int i = 0; i < SLOTS; i++) {
+		if (slots[i].inUse.load() && slots[i].epoch.load() != epoch) {
+			return false;
+		}
+	}
+	return globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates every limbo list of the parameter slot whose blocks were retired at least
+	two epochs before the parameter epoch. Only the thread holding the slot may call it.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLEpochReclaimer::freeExpired(SLSlot& slot, unsigned long epoch) {
+	for (int i = 0; i < 3; i++) {
+		if (!slot.limbo[i].empty() && slot.limboEpoch[i] + 2 <= epoch) {
+			freeLimbo(slot.limbo[i]);
+		}
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deallocates every block in a limbo list and empties it.
+
+-------------------------------------------------------------------------------------------------*/
+
+inline void SLEpochReclaimer::freeLimbo(vector<SLRetired>& toFree) {
+	for (size_t i = 0; i < toFree.size(); i++) {
+		toFree[i].destroy(toFree[i].block);
+	}
+	toFree.clear();
+};
+
+#endif // !slepoch_h
@@ -0,0 +1,162 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Blocked Bloom filter used by SkipList to answer contains for Objects that are not in the list without searching it. The filter
+	never says an Object that was added is missing, and says an Object that was never added might be present with a small chance,
+	the false positive rate.
+
+	The bits are split in to 64-byte blocks, one cache line each. An Object is hashed by the hasher it was enabled with, the hash is
+	mixed with splitmix64 (see slrandom.h) so that weak hashes such as std::hash on integers still spread out, and one half of the mixed
+	hash picks a block while 9-bit slices of a second mix pick the bits in it. A lookup costs one cache miss no matter how many bits
+	are checked, for a slightly higher false positive rate than a filter that spreads the bits of an Object over the whole array.
+
+	The filter is sized for twice the number of Objects it is reset with and is told about every Object added or removed after that.
+	A Bloom filter can not forget an Object, so a removed Object keeps its bits and only raises the false positive rate. needsRebuild
+	reports when the filter has been added to past its capacity or when more than half of the Objects added have been removed, and
+	the owner then resets it and adds every Object again, so rebuilds cost O(1) amortized per insert or remove. A stale filter,
+	one that may be missing Objects, is not used until it is rebuilt.
+
+	The hasher is stored in a std::function so that the filter, and the SkipList holding it, do not need another template parameter.
+	A hasher must give equal hashes to Objects that are equal under the comparator of the list.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slfilter_h
+#define slfilter_h
+
+//imports libraries
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "slrandom.h"
+
+using namespace std;
+
+template<class Object>
+class SLBloomFilter {
+
+	public:
+
+	typedef function<uint64_t(const Object&)> Hasher;
+
+	static const size_t MIN_CAPACITY = 256;		//Objects a filter is sized for at the least
+
+	SLBloomFilter(void) : bitsPerObject(0), probes(0), capacity(0), added(0), removed(0), stale(true) {};
+
+	//turns the filter on with the parameter hasher and bits per Object, it is stale until reset
+	void enable(const Hasher& h, double bits) {
+		hasher = h;
+		bitsPerObject = (bits < 1.0) ? 1.0 : bits;
+		probes = (int)(bitsPerObject * 0.6931 + 0.5);	//k = ln 2 bits per Object gives the lowest false positive rate
+		probes = (probes < 1) ? 1 : (probes > 16) ? 16 : probes;
+		stale = true;
+	};
+	void enableLike(const SLBloomFilter& other) {	//turns the filter on with the hasher and size of another, or off
+		if (other.enabled()) {
+			enable(other.hasher, other.bitsPerObject);
+		} else {
+			disable();
+		}
+	};
+	void disable(void) {
+		hasher = Hasher();
+		blocks.clear();
+		blocks.shrink_to_fit();
+		stale = true;
+	};
+	bool enabled(void) const { return (bool)hasher; };
+	bool active(void) const { return !stale && (bool)hasher; };	//true if lookups can use the filter
+
+	//clears every bit and sizes the filter for twice the parameter number of Objects
+	void reset(size_t expected) {
+		capacity = (2 * expected > MIN_CAPACITY) ? 2 * expected : MIN_CAPACITY;
+		size_t bits = (size_t)(capacity * bitsPerObject);
+		blocks.assign((bits + BLOCK_BITS - 1) / BLOCK_BITS, SLFilterBlock());
+		added = 0;
+		removed = 0;
+		stale = false;
+	};
+	void invalidate(void) { stale = true; };	//marks the filter as missing Objects until it is reset
+
+	void add(const Object& x) {
+		uint64_t hash = SLSplitMix(hasher(x))();
+		SLFilterBlock& block = blocks[blockOf(hash)];
+		uint64_t bits = SLSplitMix(hash)();
+		for (int i = 0; i < probes; i++) {
+			if (i > 0 && i % 7 == 0) {		//a mix holds seven 9-bit slices
+				bits = SLSplitMix(bits)();
+			}
+			unsigned bit = (unsigned)(bits >> (9 * (i % 7))) & (BLOCK_BITS - 1);
+			block.words[bit >> 6] |= (uint64_t)1 << (bit & 63);
+		}
+		added++;
+	};
+	void erase(size_t n = 1) { removed += n; };	//counts n removed Objects, their bits stay set
+
+	//returns false only if x was never added since the last reset
+	bool mayContain(const Object& x) const {
+		uint64_t hash = SLSplitMix(hasher(x))();
+		const SLFilterBlock& block = blocks[blockOf(hash)];
+		uint64_t bits = SLSplitMix(hash)();
+		for (int i = 0; i < probes; i++) {
+			if (i > 0 && i % 7 == 0) {
+				bits = SLSplitMix(bits)();
+			}
+			unsigned bit = (unsigned)(bits >> (9 * (i % 7))) & (BLOCK_BITS - 1);
+			if ((block.words[bit >> 6] & ((uint64_t)1 << (bit & 63))) == 0) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	//true once the filter is stale, full, or mostly made of removed Objects
+	bool needsRebuild(void) const {
+		return stale || added > capacity || (removed > MIN_CAPACITY / 2 && 2 * removed > added);
+	};
+
+	size_t bytes(void) const { return blocks.size() * sizeof(SLFilterBlock); };
+	double getBitsPerObject(void) const { return bitsPerObject; };
+
+	//false positive rate expected from the Objects added since the last reset, (1 - e^(-kn/m))^k
+	double expectedFalsePositiveRate(void) const {
+		if (blocks.empty()) {
+			return 0.0;
+		}
+		double m = (double)blocks.size() * BLOCK_BITS;
+		return pow(1.0 - exp(-(double)probes * added / m), probes);
+	};
+
+	private:
+
+	static const unsigned BLOCK_BITS = 512;		//bits in one block, a power of 2
+
+	struct alignas(64) SLFilterBlock {
+		uint64_t words[BLOCK_BITS / 64];
+
+		SLFilterBlock(void) : words() {};
+	};
+
+	//maps the upper half of a hash on to [0, number of blocks) without a division
+	size_t blockOf(uint64_t hash) const {
+		return (size_t)(((hash >> 32) * (uint64_t)blocks.size()) >> 32);
+	};
+
+	Hasher hasher;						//hashes an Object, empty if the filter is off
+	vector<SLFilterBlock> blocks;		//bits of the filter, one cache line per block
+	double bitsPerObject;				//bits per Object at capacity
+	int probes;							//bits set per Object
+	size_t capacity;					//Objects the filter was sized for
+	size_t added;						//Objects added since the last reset
+	size_t removed;						//Objects removed since the last reset
+	bool stale;							//true if an Object in the list may be missing from the filter
+};
+
+#endif // !slfilter_h
@@ -0,0 +1,117 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Random number generators used to pick the height of new Nodes. A generator is a small value type providing:
+
+		uint64_t operator()(void)		returns the next 64 random bits
+		void seed(uint64_t s)			restarts the sequence from the seed s
+
+	SLXorShift, xorshift64*, is the default generator of SkipList. SLSplitMix, splitmix64, is slightly slower and passes more
+	statistical tests, and is also used to scramble the seeds of SLXorShift so that nearby seeds give unrelated sequences. Both are
+	seeded with DEFAULT_SEED unless seed is called, so a program that builds the same lists in the same order always gets the same
+	heights and benchmarks can be repeated exactly.
+
+	slLevelFromWord turns one random word in to the highest level of a new Node, so picking a height costs one call to the generator
+	instead of one per level. The level has to be at least k with a chance of p^k for promotion probability p:
+		- p = 1/2: the number of trailing zero bits of the word, since each bit is zero with a chance of 1/2
+		- p = 1/4: half of the number of trailing zero bits, since each pair of bits is zero with a chance of 1/4
+		- otherwise: floor(log(u) / log(p)) for u uniform in (0, 1] made from the top 53 bits of the word
+	The caller caps the level at the height of its list.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slrandom_h
+#define slrandom_h
+
+//imports libraries
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+//splitmix64 generator
+class SLSplitMix {
+
+	public:
+
+	typedef uint64_t result_type;
+	static const uint64_t DEFAULT_SEED = 0x2545F4914F6CDD1DULL;
+
+	explicit SLSplitMix(uint64_t s = DEFAULT_SEED) : state(s) {};
+	void seed(uint64_t s) { state = s; };
+	uint64_t operator()(void) {
+		uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	};
+	static constexpr uint64_t min(void) { return 0; };
+	static constexpr uint64_t max(void) { return ~(uint64_t)0; };
+
+	private:
+
+	uint64_t state;		//advanced by a fixed odd constant on every call
+};
+
+//xorshift64* generator
+class SLXorShift {
+
+	public:
+
+	typedef uint64_t result_type;
+	static const uint64_t DEFAULT_SEED = 0x2545F4914F6CDD1DULL;
+
+	explicit SLXorShift(uint64_t s = DEFAULT_SEED) { seed(s); };
+	void seed(uint64_t s) {
+		state = SLSplitMix(s)();
+		if (state == 0) {		//xorshift never leaves the all zero state
+			state = DEFAULT_SEED;
+		}
+	};
+	uint64_t operator()(void) {
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return state * 0x2545F4914F6CDD1DULL;
+	};
+	static constexpr uint64_t min(void) { return 0; };
+	static constexpr uint64_t max(void) { return ~(uint64_t)0; };
+
+	private:
+
+	uint64_t state;		//never zero
+};
+
+//returns the number of zero bits below the lowest one bit of word, which must not be zero
+inline int slCountTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(word);
+#else
+	int zeros = 0;
+	while ((word & 1) == 0) {
+		word >>= 1;
+		zeros++;
+	}
+	return zeros;
+#endif
+}
+
+//returns the highest level of a new Node promoted with the parameter probability, from one random word
+inline int slLevelFromWord(uint64_t word, double probability) {
+	if (probability == 0.5) {
+		return slCountTrailingZeros(word | (uint64_t)1 << 63);
+	}
+	if (probability == 0.25) {
+		return slCountTrailingZeros(word | (uint64_t)1 << 63) / 2;
+	}
+	double u = ((word >> 11) + 1) * (1.0 / 9007199254740992.0);	//uniform in (0, 1]
+	double level = log(u) / log(probability);
+	return (level < 64.0) ? (int)level : 64;
+}
+
+#endif // !slrandom_h
@@ -0,0 +1,503 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	On-disk snapshots of a SkipList of trivially copyable Objects. A snapshot file is laid out as:
+
+		header		SLSnapshotHeader, 64 bytes
+		keys		count Objects in ascending order, copied byte for byte, starting at keysOffset (a multiple of 64)
+		heights		count bytes starting at heightsOffset, the highest level of the Node holding each Object
+
+	The header records a magic string, the format version, a marker to detect a file written with the other byte order, the size
+	and alignment of the Object type, and an FNV-1a checksum of the keys and of the heights.
+
+	SLSnapshotWriter streams a snapshot to disk one Object at a time, so a snapshot can be written from any sorted source, including
+	one larger than memory. The number of Objects has to be given up front, which places the heights right after the keys; the keys
+	and heights are then written through two buffered handles, each moving forward through its own part of the file.
+
+	SLMappedSnapshot maps a snapshot read-only in to memory. The keys can be used straight away, with no copy and no parsing: the
+	view has random access, iterators, and binary search with the comparator of the list. Pages are only read from disk when they are
+	touched, so opening a snapshot is O(1) no matter how large it is. verify reads the whole file and checks the checksums.
+	SkipList::assign_snapshot builds a mutable list from a view in one linear pass that keeps the height of every Node and checks the
+	checksums as it goes.
+
+	NOTE:	Snapshots are only portable between builds that agree on the size, alignment, and byte layout of the Object type.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slsnapshot_h
+#define slsnapshot_h
+
+//imports libraries
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#if defined(_WIN32)
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+struct SLSnapshotHeader {
+	char magic[8];				//"SLSNAP" followed by two zero bytes
+	uint32_t version;			//format version, SL_SNAPSHOT_VERSION
+	uint32_t byteOrder;			//SL_SNAPSHOT_BYTE_ORDER as written by the machine that saved the file
+	uint32_t keySize;			//sizeof the Object type
+	uint32_t keyAlign;			//alignof the Object type
+	uint64_t count;				//number of Objects
+	uint64_t keysOffset;		//offset of the first Object from the start of the file
+	uint64_t heightsOffset;		//offset of the first height from the start of the file
+	uint64_t keysChecksum;		//checksum of the bytes of the keys
+	uint64_t heightsChecksum;	//checksum of the heights
+};
+
+static const uint32_t SL_SNAPSHOT_VERSION = 1;
+static const uint32_t SL_SNAPSHOT_BYTE_ORDER = 0x01020304;
+static const char SL_SNAPSHOT_MAGIC[8] = { 'S', 'L', 'S', 'N', 'A', 'P', 0, 0 };
+
+//64 bit FNV-1a checksum that can be fed in pieces
+class SLChecksum {
+
+	public:
+
+	SLChecksum(void) : hash(0xCBF29CE484222325ULL) {};
+	void add(const void* data, size_t bytes) {
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < bytes; i++) {
+			hash = (hash ^ p[i]) * 0x100000001B3ULL;
+		}
+	};
+	uint64_t value(void) const { return hash; };
+
+	private:
+
+	uint64_t hash;
+};
+
+//returns the offset of the keys of a snapshot, the header rounded up to a multiple of 64 and of the key alignment
+inline uint64_t slSnapshotKeysOffset(size_t keyAlign) {
+	uint64_t align = (keyAlign > 64) ? keyAlign : 64;
+	return (sizeof(SLSnapshotHeader) + align - 1) / align * align;
+}
+
+//moves a file to a byte offset from the start, with a 64-bit offset even where long is 32 bits
+inline bool slSnapshotSeek(FILE* file, uint64_t offset) {
+#if defined(_WIN32)
+	return _fseeki64(file, (__int64)offset, SEEK_SET) == 0;
+#else
+	return fseeko(file, (off_t)offset, SEEK_SET) == 0;	//off_t is 64 bits on 32-bit builds with _FILE_OFFSET_BITS=64
+#endif
+}
+
+//writes a snapshot one Object at a time
+template<class Object>
+class SLSnapshotWriter {
+
+	static_assert(is_trivially_copyable<Object>::value, "snapshots require a trivially copyable Object");
+
+	public:
+
+	SLSnapshotWriter(const string& path, uint64_t count);	//creates the file for count Objects
+	~SLSnapshotWriter(void);								//closes the file, finish must have been called to keep it
+	void append(const Object& key, int height);				//writes the next Object, keys must come in ascending order
+	void finish(void);										//writes the header and closes the file
+
+	private:
+
+	SLSnapshotWriter(const SLSnapshotWriter&);
+	void operator=(const SLSnapshotWriter&);
+	void fail(const char* what);							//closes the file and throws
+
+	string path;				//path of the file being written
+	FILE* keys;					//handle writing the keys
+	FILE* heights;				//handle writing the heights
+	SLSnapshotHeader header;	//header written by finish
+	uint64_t written;			//number of Objects appended so far
+	SLChecksum keysChecksum;
+	SLChecksum heightsChecksum;
+};
+
+//read-only view of a snapshot mapped in to memory
+template<class Object, class Compare = less<Object> >
+class SLMappedSnapshot {
+
+	static_assert(is_trivially_copyable<Object>::value, "snapshots require a trivially copyable Object");
+
+	public:
+
+	typedef const Object* const_iterator;
+
+	explicit SLMappedSnapshot(const string& path, const Compare& comp = Compare());	//maps the snapshot at path
+	SLMappedSnapshot(SLMappedSnapshot&& toMove);
+	~SLMappedSnapshot(void);							//unmaps the file
+
+	size_t size(void) const { return (size_t)count; };	//returns the number of Objects
+	bool isEmpty(void) const { return count == 0; };	//returns true if the snapshot holds no Objects
+	const Object& operator[](size_t index) const { return keys[index]; };	//returns the Object at index
+	int height(size_t index) const { return heights[index]; };	//returns the level of the Node that held the Object at index
+	const_iterator begin(void) const { return keys; };	//returns an iterator to the smallest Object
+	const_iterator end(void) const { return keys + count; };	//returns an iterator past the largest Object
+	bool contains(const Object& target) const;			//returns true if the target is in the snapshot
+	const_iterator lower_bound(const Object& target) const;	//returns an iterator to the first Object not less than target
+	const_iterator upper_bound(const Object& target) const;	//returns an iterator to the first Object greater than target
+	bool verify(void) const;							//returns true if the checksums match the contents
+	const SLSnapshotHeader& getHeader(void) const { return *header; };
+
+	private:
+
+	SLMappedSnapshot(const SLMappedSnapshot&);
+	void operator=(const SLMappedSnapshot&);
+	void unmap(void);
+
+	Compare compare;					//order the snapshot was saved in
+	void* base;							//start of the mapping
+	size_t bytes;						//length of the mapping
+	const SLSnapshotHeader* header;		//header at the start of the mapping
+	const Object* keys;					//sorted Objects
+	const unsigned char* heights;		//level of each Object
+	uint64_t count;						//number of Objects
+#if defined(_WIN32)
+	vector<char> buffer;				//file contents, read in whole where mmap is not available
+#endif
+};
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Creates the file at the parameter path, truncating it, and reserves room for
+	the header, count Objects, and count heights. Throws runtime_error if the file can not be
+	opened.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+SLSnapshotWriter<Object>::SLSnapshotWriter(const string& path, uint64_t count) : path(path), keys(NULL), heights(NULL), written(0) {
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SL_SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SL_SNAPSHOT_VERSION;
+	header.byteOrder = SL_SNAPSHOT_BYTE_ORDER;
+	header.keySize = sizeof(Object);
+	header.keyAlign = alignof(Object);
+	header.count = count;
+	header.keysOffset = slSnapshotKeysOffset(alignof(Object));
+	header.heightsOffset = header.keysOffset + count * sizeof(Object);
+
+	keys = fopen(path.c_str(), "wb");
+	if (keys == NULL) {
+		fail("SLSnapshotWriter: can not create file");
+	}
+	static const char zeros[64] = { 0 };
+	for (uint64_t padded = 0; padded < header.keysOffset; padded += sizeof(zeros)) {	//pads the header out to the keys
+		size_t length = (header.keysOffset - padded < sizeof(zeros)) ? (size_t)(header.keysOffset - padded) : sizeof(zeros);
+		if (fwrite(zeros, 1, length, keys) != length) {
+			fail("SLSnapshotWriter: write failed");
+		}
+	}
+	if (fflush(keys) != 0) {
+		fail("SLSnapshotWriter: write failed");
+	}
+	heights = fopen(path.c_str(), "r+b");
+	if (heights == NULL || !slSnapshotSeek(heights, header.heightsOffset)) {
+		fail("SLSnapshotWriter: can not open file for heights");
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. Closes the file. A snapshot that was not finished has no valid header and is
+	removed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+SLSnapshotWriter<Object>::~SLSnapshotWriter(void) {
+	if (keys != NULL || heights != NULL) {
+		if (keys != NULL) {
+			fclose(keys);
+		}
+		if (heights != NULL) {
+			fclose(heights);
+		}
+		remove(path.c_str());
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method writes the next Object of the snapshot and the level of the Node that holds it. The
+	Objects must be appended in ascending order. Throws runtime_error if more Objects are
+	appended than the writer was created for or the write fails.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void SLSnapshotWriter<Object>::append(const Object& key, int height) {
+	if (written == header.count) {
+		fail("SLSnapshotWriter: more Objects than the snapshot was created for");
+	}
+	unsigned char level = (unsigned char)height;
+	if (fwrite(&key, sizeof(Object), 1, keys) != 1 || fputc(level, heights) == EOF) {
+		fail("SLSnapshotWriter: write failed");
+	}
+	keysChecksum.add(&key, sizeof(Object));
+	heightsChecksum.add(&level, 1);
+	written++;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method writes the header with the checksums and closes the file. Throws runtime_error if
+	fewer Objects were appended than the writer was created for or a write fails.
+
+	POSTCONDITIONS:
+		- the file at path is a complete snapshot
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void SLSnapshotWriter<Object>::finish(void) {
+	if (written != header.count) {
+		fail("SLSnapshotWriter: fewer Objects than the snapshot was created for");
+	}
+	header.keysChecksum = keysChecksum.value();
+	header.heightsChecksum = heightsChecksum.value();
+	bool ok = fclose(keys) == 0;
+	keys = NULL;
+	ok = ok && slSnapshotSeek(heights, 0) && fwrite(&header, sizeof(header), 1, heights) == 1;
+	ok = (fclose(heights) == 0) && ok;
+	heights = NULL;
+	if (!ok) {
+		remove(path.c_str());
+		throw runtime_error("SLSnapshotWriter: write failed");
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method closes and removes the partly written file and throws runtime_error with the
+	parameter message.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object>
+void SLSnapshotWriter<Object>::fail(const char* what) {
+	if (keys != NULL) {
+		fclose(keys);
+		keys = NULL;
+	}
+	if (heights != NULL) {
+		fclose(heights);
+		heights = NULL;
+	}
+	remove(path.c_str());
+	throw runtime_error(what);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Maps the snapshot at the parameter path read-only and checks its header. The
+	contents are not read, so this takes O(1). Throws runtime_error if the file can not be
+	mapped, is not a snapshot, was written for a different Object type or byte order, or is
+	shorter than its header says.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+SLMappedSnapshot<Object, Compare>::SLMappedSnapshot(const string& path, const Compare& comp)
+	: compare(comp), base(NULL), bytes(0), header(NULL), keys(NULL), heights(NULL), count(0) {
+#if defined(_WIN32)
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == NULL) {
+		throw runtime_error("SLMappedSnapshot: can not open file");
+	}
+	_fseeki64(file, 0, SEEK_END);
+	bytes = (size_t)_ftelli64(file);
+	_fseeki64(file, 0, SEEK_SET);
+	buffer.resize(bytes + 64);
+	size_t shift = (64 - (reinterpret_cast<uintptr_t>(buffer.data()) % 64)) % 64;	//aligns the copy like a mapping
+	bool ok = fread(buffer.data() + shift, 1, bytes, file) == bytes;
+	fclose(file);
+	if (!ok) {
+		throw runtime_error("SLMappedSnapshot: read failed");
+	}
+	base = buffer.data() + shift;
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw runtime_error("SLMappedSnapshot: can not open file");
+	}
+	struct stat info;
+	if (fstat(file, &info) != 0) {
+		close(file);
+		throw runtime_error("SLMappedSnapshot: can not read file size");
+	}
+	bytes = (size_t)info.st_size;
+	if (bytes < sizeof(SLSnapshotHeader)) {
+		close(file);
+		throw runtime_error("SLMappedSnapshot: not a snapshot");
+	}
+	base = mmap(NULL, bytes, PROT_READ, MAP_SHARED, file, 0);
+	close(file);		//the mapping stays valid after the file is closed
+	if (base == MAP_FAILED) {
+		base = NULL;
+		throw runtime_error("SLMappedSnapshot: can not map file");
+	}
+#endif
+
+	header = static_cast<const SLSnapshotHeader*>(base);
+	const char* problem = NULL;
+	if (bytes < sizeof(SLSnapshotHeader) || memcmp(header->magic, SL_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+		problem = "SLMappedSnapshot: not a snapshot";
+	} else if (header->version != SL_SNAPSHOT_VERSION) {
+		problem = "SLMappedSnapshot: unsupported version";
+	} else if (header->byteOrder != SL_SNAPSHOT_BYTE_ORDER) {
+		problem = "SLMappedSnapshot: written with a different byte order";
+	} else if (header->keySize != sizeof(Object) || header->keyAlign != alignof(Object)) {
+		problem = "SLMappedSnapshot: written for a different Object type";
+	} else if (header->keysOffset % alignof(Object) != 0 || header->keysOffset > bytes
+		|| header->count > (bytes - header->keysOffset) / sizeof(Object)
+		|| header->heightsOffset != header->keysOffset + header->count * sizeof(Object)
+		|| header->count > bytes - header->heightsOffset) {
+		problem = "SLMappedSnapshot: file is truncated";
+	}
+	if (problem != NULL) {
+		unmap();
+		throw runtime_error(problem);
+	}
+	count = header->count;
+	keys = reinterpret_cast<const Object*>(static_cast<const char*>(base) + header->keysOffset);
+	heights = static_cast<const unsigned char*>(base) + header->heightsOffset;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Move constructor. Takes over the mapping of the parameter view, which is left empty.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+SLMappedSnapshot<Object, Compare>::SLMappedSnapshot(SLMappedSnapshot&& toMove)
+	: compare(toMove.compare), base(toMove.base), bytes(toMove.bytes), header(toMove.header), keys(toMove.keys),
+	heights(toMove.heights), count(toMove.count) {
+#if defined(_WIN32)
+	buffer.swap(toMove.buffer);
+#endif
+	toMove.base = NULL;
+	toMove.bytes = 0;
+	toMove.header = NULL;
+	toMove.keys = NULL;
+	toMove.heights = NULL;
+	toMove.count = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. Unmaps the file. Iterators and references in to the view become invalid.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+SLMappedSnapshot<Object, Compare>::~SLMappedSnapshot(void) {
+	unmap();
+};
+
+template<class Object, class Compare>
+void SLMappedSnapshot<Object, Compare>::unmap(void) {
+#if !defined(_WIN32)
+	if (base != NULL) {
+		munmap(base, bytes);
+	}
+#endif
+	base = NULL;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first Object in the snapshot not less than the target
+	parameter, or end(), with a binary search of the keys in O(logn). Only the pages the search
+	touches are read from disk.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+typename SLMappedSnapshot<Object, Compare>::const_iterator SLMappedSnapshot<Object, Compare>::lower_bound(const Object& target) const {
+	const Object* first = keys;
+	size_t length = (size_t)count;
+	while (length > 0) {
+		size_t half = length / 2;
+		if (compare(first[half], target)) {
+			first += half + 1;
+			length -= half + 1;
+		} else {
+			length = half;
+		}
+	}
+	return first;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first Object in the snapshot greater than the target
+	parameter, or end(), with a binary search of the keys in O(logn).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+typename SLMappedSnapshot<Object, Compare>::const_iterator SLMappedSnapshot<Object, Compare>::upper_bound(const Object& target) const {
+	const Object* first = keys;
+	size_t length = (size_t)count;
+	while (length > 0) {
+		size_t half = length / 2;
+		if (!compare(target, first[half])) {
+			first += half + 1;
+			length -= half + 1;
+		} else {
+			length = half;
+		}
+	}
+	return first;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target parameter is in the snapshot. Calls lower_bound as a
+	helper function.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+bool SLMappedSnapshot<Object, Compare>::contains(const Object& target) const {
+	const_iterator found = lower_bound(target);
+	return found != end() && !compare(target, *found);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method reads every key and height of the snapshot and returns true if their checksums match
+	the ones in the header. Runs in O(n) and reads the whole file.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare>
+bool SLMappedSnapshot<Object, Compare>::verify(void) const {
+	SLChecksum keysChecksum, heightsChecksum;
+	keysChecksum.add(keys, (size_t)count * sizeof(Object));
+	heightsChecksum.add(heights, (size_t)count);
+	return keysChecksum.value() == header->keysChecksum && heightsChecksum.value() == header->heightsChecksum;
+};
+
+#endif // !slsnapshot_h
@@ -0,0 +1,224 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Statistics policies for the SkipList class. The Stats template parameter of a SkipList is told about every search, comparison,
+	step, and Node allocation the list makes:
+
+		void beginSearch(void)					a search is starting at the top of the list
+		void atLevel(int l)						the search moved down to level l
+		void compared(void)						a Node was compared to the target of the search
+		void moved(void)						the search moved right to the next Node on the current level
+		void allocated(int l, size_t bytes)		a Node on level l was allocated
+		void deallocated(int l, size_t bytes)	a Node on level l was deallocated
+		void releasedAll(void)					every Node was dropped at once
+		void filterRejected(void)				contains was answered by the membership filter (see slfilter.h)
+		void filterPassed(bool found)			the filter let a contains through to a search, found if the Object was there
+		void filterResized(size_t bytes)		the filter was rebuilt and now takes bytes
+		unsigned long long comparisons(void) const	number of comparisons recorded
+
+	SLNoStats is the default. Every hook is empty and inlined, so a list without statistics compiles to the same code as if the
+	hooks were not there.
+
+	SLStats records:
+		- comparisons and steps to the right made by searches, split by the level they were made on
+		- the average search path length, steps right plus steps down, which expectedPathLength compares with the
+		  expected length log(1/p) n / p + 1 / (1 - p) from Pugh's analysis. A path much longer than expected means the heights
+		  in the list are no longer well spread
+		- the height histogram, the number of Nodes whose top level is l
+		- the number of Node allocations and deallocations and the bytes held by live Nodes
+		- for a list with a membership filter, the lookups it rejected, the lookups it let through, the false positive rate
+		  seen (lookups let through for Objects that were not there, over all lookups for missing Objects), and its size
+
+	Searches are sampled: only one search in every sampleEvery is recorded, 1 by default, so that statistics can be left on in
+	production at the cost of a counter and a branch per search and a branch per hook. The height histogram and allocation
+	counts are updated on every allocation since they describe the list, not the searches.
+
+	NOTE:	Statistics are updated by searches made through const methods, so a list with SLStats can not be read by several
+			threads at once even though nothing else in it changes.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef slstats_h
+#define slstats_h
+
+//imports libraries
+#include <cmath>
+#include <cstddef>
+
+using namespace std;
+
+//records nothing
+struct SLNoStats {
+	void beginSearch(void) {};
+	void atLevel(int) {};
+	void compared(void) {};
+	void moved(void) {};
+	void allocated(int, size_t) {};
+	void deallocated(int, size_t) {};
+	void releasedAll(void) {};
+	void filterRejected(void) {};
+	void filterPassed(bool) {};
+	void filterResized(size_t) {};
+	unsigned long long comparisons(void) const { return 0; };
+};
+
+//records sampled search statistics, the height histogram, and Node allocations
+class SLStats {
+
+	public:
+
+	static const int LEVELS = 32;	//levels tracked, at least the MAX_LEVEL of a SkipList
+
+	SLStats(void) : sampleEvery(1), countdown(1), sampling(false), level(0) {
+		reset();
+		for (int l = 0; l < LEVELS; l++) {
+			heights[l] = 0;
+		}
+		nodeAllocations = 0;
+		nodeDeallocations = 0;
+		bytesLive = 0;
+		bytesFilter = 0;
+	};
+
+	//hooks called by the SkipList
+	void beginSearch(void) {
+		if (--countdown == 0) {
+			countdown = sampleEvery;
+			sampling = true;
+			sampledSearches++;
+		} else {
+			sampling = false;
+		}
+		level = 0;
+	};
+	void atLevel(int l) {
+		if (sampling) {
+			level = l;
+			levelSteps++;
+		}
+	};
+	void compared(void) {
+		if (sampling) {
+			levelComparisons[level]++;
+		}
+	};
+	void moved(void) {
+		if (sampling) {
+			levelMoves[level]++;
+		}
+	};
+	void allocated(int l, size_t bytes) {
+		heights[l]++;
+		nodeAllocations++;
+		bytesLive += bytes;
+	};
+	void deallocated(int l, size_t bytes) {
+		heights[l]--;
+		nodeDeallocations++;
+		bytesLive -= bytes;
+	};
+	void releasedAll(void) {
+		for (int l = 0; l < LEVELS; l++) {
+			nodeDeallocations += heights[l];
+			heights[l] = 0;
+		}
+		bytesLive = 0;
+	};
+	void filterRejected(void) {
+		lookupsRejected++;
+	};
+	void filterPassed(bool found) {
+		lookupsPassed++;
+		if (!found) {
+			lookupsFalsePositive++;
+		}
+	};
+	void filterResized(size_t bytes) {
+		bytesFilter = bytes;
+	};
+
+	//records one search in every n, n of 0 is treated as 1
+	void setSampleEvery(unsigned long n) { sampleEvery = (n == 0) ? 1 : n; countdown = sampleEvery; };
+	unsigned long getSampleEvery(void) const { return sampleEvery; };
+
+	//clears the search and filter statistics, the histogram, allocation counts, and filter size are kept
+	void reset(void) {
+		for (int l = 0; l < LEVELS; l++) {
+			levelComparisons[l] = 0;
+			levelMoves[l] = 0;
+		}
+		sampledSearches = 0;
+		levelSteps = 0;
+		lookupsRejected = 0;
+		lookupsPassed = 0;
+		lookupsFalsePositive = 0;
+	};
+
+	unsigned long long searches(void) const { return sampledSearches; };
+	unsigned long long comparisonsAt(int l) const { return levelComparisons[l]; };
+	unsigned long long movesAt(int l) const { return levelMoves[l]; };
+	unsigned long long comparisons(void) const {
+		unsigned long long total = 0;
+		for (int l = 0; l < LEVELS; l++) {
+			total += levelComparisons[l];
+		}
+		return total;
+	};
+	unsigned long long moves(void) const {
+		unsigned long long total = 0;
+		for (int l = 0; l < LEVELS; l++) {
+			total += levelMoves[l];
+		}
+		return total;
+	};
+	double averageComparisons(void) const { return sampledSearches ? (double)comparisons() / sampledSearches : 0.0; };
+	double averagePathLength(void) const { return sampledSearches ? (double)(moves() + levelSteps) / sampledSearches : 0.0; };
+
+	//expected search path length in a list of n Nodes promoted with probability p
+	static double expectedPathLength(size_t n, double p) {
+		if (n < 2) {
+			return 1.0;
+		}
+		return log((double)n) / log(1.0 / p) / p + 1.0 / (1.0 - p);
+	};
+
+	unsigned long long height(int l) const { return heights[l]; };	//number of Nodes whose top level is l
+	unsigned long long allocations(void) const { return nodeAllocations; };
+	unsigned long long deallocations(void) const { return nodeDeallocations; };
+	size_t liveBytes(void) const { return bytesLive; };
+
+	unsigned long long filterRejections(void) const { return lookupsRejected; };	//lookups answered by the filter
+	unsigned long long filterPasses(void) const { return lookupsPassed; };			//lookups the filter let through
+	unsigned long long filterFalsePositives(void) const { return lookupsFalsePositive; };	//lookups let through for missing Objects
+	double falsePositiveRate(void) const {
+		unsigned long long misses = lookupsRejected + lookupsFalsePositive;
+		return misses ? (double)lookupsFalsePositive / misses : 0.0;
+	};
+	size_t filterBytes(void) const { return bytesFilter; };	//bytes taken by the filter, 0 without one
+
+	private:
+
+	unsigned long sampleEvery;						//one search in this many is recorded
+	unsigned long countdown;						//searches left until the next recorded one
+	bool sampling;									//true while a recorded search is running
+	int level;										//level the recorded search is on
+	unsigned long long sampledSearches;				//number of recorded searches
+	unsigned long long levelSteps;					//levels descended by recorded searches
+	unsigned long long levelComparisons[LEVELS];	//comparisons made by recorded searches on each level
+	unsigned long long levelMoves[LEVELS];			//steps right made by recorded searches on each level
+	unsigned long long heights[LEVELS];				//number of live Nodes whose top level is each level
+	unsigned long long nodeAllocations;				//Nodes allocated
+	unsigned long long nodeDeallocations;			//Nodes deallocated
+	size_t bytesLive;								//bytes held by live Nodes
+	unsigned long long lookupsRejected;				//lookups answered by the filter
+	unsigned long long lookupsPassed;				//lookups the filter let through to a search
+	unsigned long long lookupsFalsePositive;		//lookups let through for Objects that were not in the list
+	size_t bytesFilter;								//bytes taken by the filter
+};
+
+#endif // !slstats_h
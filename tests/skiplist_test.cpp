@@ -0,0 +1,173 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	Single-threaded correctness checks for SkipList and SkipMap, run by ctest. Each check prints its name and ok or FAILED, and the
+	program exits with a non-zero status if any of them failed.
+		- map moves: moves a SkipMap by construction and by assignment, and checks that the entries went with it and the map moved
+		  from is empty. Also keeps lists of Objects that can not be assigned, such as map entries, compiling.
+		- pop and range erase: runs random pop_min, pop_max, erase_range, erase_until, and remove calls on a SkipList and a
+		  std::set side by side, with and without an index and a membership filter, and compares the two after every call,
+		  walking the list forward, backward along the previous links, and by index.
+
+	Usage:	skiplist_test
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../skiplist.h"
+#include "../skipmap.h"
+
+using namespace std;
+
+//moves a map by construction and by assignment and checks that the entries went with it
+bool checkMapMoves(void) {
+	SkipMap<int, string> original;
+	for (int key = 0; key < 100; key++) {
+		original.try_emplace(key, to_string(key));
+	}
+	SkipMap<int, string> constructed(std::move(original));
+	bool passed = original.size() == 0 && constructed.size() == 100;
+	SkipMap<int, string> assigned;
+	assigned.try_emplace(1000, "replaced");
+	assigned = std::move(constructed);
+	passed = passed && constructed.size() == 0 && assigned.size() == 100;
+	passed = passed && assigned.contains(42) && assigned.at(42) == "42" && !assigned.contains(1000);
+	constructed.try_emplace(7, "7");		//a map moved from can be used again
+	passed = passed && constructed.size() == 1 && constructed.at(7) == "7";
+	printf("check SkipMap moves: %s\n", passed ? "ok" : "FAILED");
+	return passed;
+}
+
+//true if list holds the keys of model, read forward, backward, and by index, and finds the keys it should
+template<bool Indexed, class CheckedList>
+bool sameKeys(const CheckedList& list, const set<long long>& model, mt19937_64& random) {
+	if (list.size() != (int)model.size() || !equal(list.begin(), list.end(), model.begin(), model.end())) {
+		return false;
+	}
+	typename CheckedList::const_iterator node = list.end();
+	for (set<long long>::const_reverse_iterator it = model.rbegin(); it != model.rend(); ++it) {
+		if (*--node != *it) {
+			return false;
+		}
+	}
+	if (!model.empty() && (list.peek_min() != *model.begin() || --node != list.end())) {	//the first Node has no previous Node
+		return false;
+	}
+	int total = 0;
+	vector<int> heights = list.level_histogram();
+	for (size_t l = 0; l < heights.size(); l++) {
+		total += heights[l];
+	}
+	if (total != (int)model.size()) {
+		return false;
+	}
+	if constexpr (Indexed) {
+		int index = 0;
+		for (set<long long>::const_iterator it = model.begin(); it != model.end(); ++it, index++) {
+			if (list.at(index) != *it || list.rank(*it) != index) {
+				return false;
+			}
+		}
+	}
+	for (int i = 0; i < 32; i++) {
+		long long key = (long long)(random() % 4096);
+		if (list.contains(key) != (model.count(key) != 0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//runs random priority queue calls and range erases on a SkipList and a std::set and compares them after each call
+template<bool Indexed>
+bool checkRangeErase(bool filtered) {
+	SkipList<long long, less<long long>, SLPoolAllocator, Indexed> list;
+	set<long long> model;
+	mt19937_64 random(Indexed * 2 + filtered + 1);
+	if (filtered) {
+		list.enable_filter([](const long long& key) { return (uint64_t)key; });
+	}
+
+	bool passed = true;
+	for (int round = 0; round < 2000 && passed; round++) {
+		for (int i = (int)(random() % 16); i > 0; i--) {
+			long long key = (long long)(random() % 4096);
+			if (list.insert(key) == (model.count(key) != 0)) {
+				passed = false;
+			}
+			model.insert(key);
+		}
+		long long low = (long long)(random() % 4096);
+		long long high = low + (long long)(random() % 512);
+		int removed = 0;			//Objects removed from the model
+		int reported = 0;			//Objects the list says it removed
+		switch (random() % 5) {
+			case 0: {
+				optional<long long> popped = list.pop_min();
+				passed = passed && popped.has_value() == !model.empty() && (model.empty() || *popped == *model.begin());
+				if (!model.empty()) {
+					model.erase(model.begin());
+				}
+				break;
+			}
+			case 1: {
+				optional<long long> popped = list.pop_max();
+				passed = passed && popped.has_value() == !model.empty() && (model.empty() || *popped == *model.rbegin());
+				if (!model.empty()) {
+					model.erase(--model.end());
+				}
+				break;
+			}
+			case 2:
+				if (random() % 4 == 0) {		//often starts at or below the smallest key
+					low = model.empty() ? 0 : *model.begin() - (long long)(random() % 2);
+				}
+				reported = list.erase_range(low, high);
+				for (set<long long>::iterator it = model.lower_bound(low); it != model.end() && *it < high; removed++) {
+					it = model.erase(it);
+				}
+				passed = passed && reported == removed;
+				break;
+			case 3:
+				reported = list.erase_until(low / 8);
+				for (set<long long>::iterator it = model.begin(); it != model.end() && *it < low / 8; removed++) {
+					it = model.erase(it);
+				}
+				passed = passed && reported == removed;
+				break;
+			default:
+				passed = passed && list.remove(low) == (model.erase(low) != 0);
+				break;
+		}
+		passed = passed && sameKeys<Indexed>(list, model, random);
+	}
+	return passed;
+}
+
+//runs the range erase check on every configuration and prints the result
+bool checkRangeErases(void) {
+	bool passed = checkRangeErase<false>(false);
+	passed = checkRangeErase<false>(true) && passed;
+	passed = checkRangeErase<true>(false) && passed;
+	passed = checkRangeErase<true>(true) && passed;
+	printf("check SkipList pop and range erase: %s\n", passed ? "ok" : "FAILED");
+	return passed;
+}
+
+int main(void) {
+	bool passed = checkMapMoves();
+	passed = checkRangeErases() && passed;
+	return passed ? 0 : 1;
+}
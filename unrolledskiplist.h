@@ -0,0 +1,819 @@
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+
+	Author:		Boyer, Destiny
+	Project:	Skip List
+	Professor:	Rob Nash
+	Class:		CSS342
+
+	This is a templatized class implementing an unrolled Skip List, a Skip List whose Nodes each hold a sorted run of up to Capacity
+	Objects instead of one. Capacity defaults to one cache line of Objects, 16 32-bit or 8 64-bit integers, and the Objects are stored
+	at the start of a Node aligned to a cache line, so searching inside a Node costs one cache miss. Nodes are towers of pointers like
+	the Nodes of SkipList, but the pointer on each level also carries a copy of the smallest Object of the Node it points to. A search
+	decides whether to move right by comparing the target with the copy held in the current Node, so it only loads the Nodes it
+	actually moves to. With n Objects the list has about n / Capacity Nodes, which takes log2(Capacity) levels off of every search.
+
+	Searching the list walks the levels from the top, moving right while the smallest Object of the next Node comes before the target,
+	then searches the Node it stopped at. For 32 and 64-bit integers ordered with std::less, the Node is searched by comparing the
+	target with every slot of the Node at once using AVX2, or SSE2 and SSE4.2, and counting the slots less than the target. Unused
+	slots hold the largest value of the type so they are never counted. Other Objects and comparators use a binary search of the
+	Node, and integers fall back to a branch free scalar count when the vector instructions are not enabled at compile time.
+
+	Inserting in to a full Node splits it in to two half full Nodes, and the new upper half gets a random height picked the same way
+	as a Node of SkipList (see slrandom.h). Removing the last Object of a Node unlinks it, and a Node that shrinks until it and the
+	Node after it fit in three quarters of a Node absorbs that Node, so the list stays dense.
+
+	NOTE:	Objects must be default constructible and assignable, since every slot of a Node holds an Object.
+
+	NOTE:	Building with -march=native (the SKIPLIST_NATIVE CMake option) enables the AVX2 search on machines that support it.
+
+---------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef unrolledskiplist_h
+#define unrolledskiplist_h
+
+//imports libraries
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "slrandom.h"
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+//true if Nodes of Objects ordered by Compare are searched with vector instructions
+template<class Object, class Compare>
+struct ULVectorSearch {
+	static const bool enabled = is_integral<Object>::value && !is_same<Object, bool>::value
+		&& (sizeof(Object) == 4 || sizeof(Object) == 8)
+		&& (is_same<Compare, less<Object> >::value || is_same<Compare, less<void> >::value);
+};
+
+//returns the number of the Capacity integers at keys that are less than target. keys must be aligned to 64 bytes
+template<class T, int Capacity>
+inline int ulCountLess(const T* keys, T target) {
+	int count = 0;
+#if defined(__AVX2__)
+	if constexpr ((Capacity * sizeof(T)) % 32 == 0) {
+		__m256i flip = is_signed<T>::value ? _mm256_setzero_si256()		//unsigned integers are compared with their
+			: (sizeof(T) == 8 ? _mm256_set1_epi64x((long long)0x8000000000000000ULL) : _mm256_set1_epi32((int)0x80000000U));	//sign bits flipped
+		__m256i goal = _mm256_xor_si256(sizeof(T) == 8 ? _mm256_set1_epi64x((long long)target) : _mm256_set1_epi32((int)target), flip);
+		for (int i = 0; i < Capacity; i += 32 / (int)sizeof(T)) {
+			__m256i slots = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i)), flip);
+			__m256i less = (sizeof(T) == 8) ? _mm256_cmpgt_epi64(goal, slots) : _mm256_cmpgt_epi32(goal, slots);
+			count += __builtin_popcount((unsigned)_mm256_movemask_epi8(less));
+		}
+		return count / (int)sizeof(T);		//the mask has one bit per byte of each slot
+	}
+#elif defined(__SSE2__)
+#if defined(__SSE4_2__)
+	const bool wide = true;			//64-bit slots need _mm_cmpgt_epi64 from SSE4.2
+#else
+	const bool wide = false;
+#endif
+	if constexpr ((Capacity * sizeof(T)) % 16 == 0) {
+		if (sizeof(T) == 4 || wide) {
+			__m128i flip = is_signed<T>::value ? _mm_setzero_si128()
+				: (sizeof(T) == 8 ? _mm_set1_epi64x((long long)0x8000000000000000ULL) : _mm_set1_epi32((int)0x80000000U));
+			__m128i goal = _mm_xor_si128(sizeof(T) == 8 ? _mm_set1_epi64x((long long)target) : _mm_set1_epi32((int)target), flip);
+			for (int i = 0; i < Capacity; i += 16 / (int)sizeof(T)) {
+				__m128i slots = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(keys + i)), flip);
+#if defined(__SSE4_2__)
+				__m128i less = (sizeof(T) == 8) ? _mm_cmpgt_epi64(goal, slots) : _mm_cmpgt_epi32(goal, slots);
+#else
+				__m128i less = _mm_cmpgt_epi32(goal, slots);
+#endif
+				count += __builtin_popcount((unsigned)_mm_movemask_epi8(less));
+			}
+			return count / (int)sizeof(T);
+		}
+	}
+#endif
+	for (int i = 0; i < Capacity; i++) {		//scalar fallback, compiles to a branch free count
+		count += keys[i] < target;
+	}
+	return count;
+}
+
+template<class Object, class Compare = less<Object>, int Capacity = (64 / sizeof(Object) >= 4 ? 64 / sizeof(Object) : 4)>
+
+class UnrolledSkipList {
+
+	static_assert(Capacity >= 4, "a Node must hold at least four Objects");
+
+	private:
+
+	struct ULNode;
+
+	struct ULLink {
+		ULNode* node;		//next Node on the level, NULL at the end of the level
+		Object first;		//copy of the smallest Object in node
+	};
+
+	struct alignas(64) ULNode {
+		Object keys[Capacity];	//sorted Objects, slots past size hold the padding Object
+		int size;				//number of Objects in the Node
+		int level;				//highest level that the Node is on
+		ULLink next[1];			//links to the next Node on each level, allocated with level + 1 entries
+	};
+
+	typedef ULVectorSearch<Object, Compare> Vector;
+
+	public:
+
+	//forward iterator over every Object in order. Objects can not be changed through an iterator
+	class const_iterator {
+
+		public:
+
+		typedef forward_iterator_tag iterator_category;
+		typedef Object value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const Object* pointer;
+		typedef const Object& reference;
+
+		const_iterator(void) : node(NULL), index(0) {};
+		reference operator*(void) const { return node->keys[index]; };
+		pointer operator->(void) const { return &node->keys[index]; };
+		const_iterator& operator++(void) {
+			if (++index == node->size) {
+				node = node->next[0].node;
+				index = 0;
+			}
+			return *this;
+		};
+		const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; };
+		bool operator==(const const_iterator& other) const { return node == other.node && index == other.index; };
+		bool operator!=(const const_iterator& other) const { return !(*this == other); };
+
+		private:
+
+		friend class UnrolledSkipList;
+		const_iterator(ULNode* n, int i) : node(n), index(i) {};
+
+		ULNode* node;	//Node holding the current Object, NULL at the end
+		int index;		//slot of the current Object in node
+	};
+
+	typedef const_iterator iterator;
+
+	UnrolledSkipList(void);								//Default no-args constructor
+	explicit UnrolledSkipList(double promotion, const Compare& comp = Compare());	//constructor taking the promotion probability
+	UnrolledSkipList(const UnrolledSkipList& toCopy);	//Copy constructor
+	~UnrolledSkipList(void);							//Destructor
+	void operator=(const UnrolledSkipList& toCopy);		//overloaded assignment operator
+	int size(void) const;								//returns the number of Objects in the list
+	bool isEmpty(void) const;							//returns true if there are no Objects in the list
+	int nodes(void) const;								//returns the number of Nodes holding the Objects
+	bool contains(const Object& target) const;			//returns true if the target is in the list
+	bool insert(const Object& toInsert);				//inserts the Object, false if it is already in the list
+	bool remove(const Object& toRemove);				//removes the Object, false if it is not in the list
+	void makeEmpty(void);								//deletes every Node
+	void show(void) const;								//displays the list, one Node per row
+	const_iterator begin(void) const;					//returns an iterator to the smallest Object
+	const_iterator end(void) const;						//returns an iterator past the largest Object
+	const_iterator lower_bound(const Object& target) const;	//returns an iterator to the first Object not less than target
+
+	private:
+
+	static Object padding(void);						//value stored in unused slots
+	int countLess(const ULNode* node, const Object& target) const;	//returns the number of Objects in node less than target
+	bool locate(const Object& target, ULNode** update, ULNode*& node, int& slot) const;	//finds the Node and slot for target
+	void setFirst(ULNode* node, ULNode** update);		//copies the new smallest Object of node in to the links to it
+	ULNode* split(ULNode* node, ULNode** update);		//moves the upper half of a full Node to a new Node
+	void absorbNext(ULNode* node, ULNode** update);		//moves the Objects of the next Node in to node
+	void unlinkNode(ULNode* node, ULNode* const* predecessors);	//unlinks a Node from every level it is on and deletes it
+	int randomLevel(void);								//picks the highest level for a new Node
+	ULNode* createNode(int l);							//allocates an empty Node on level l
+	void deleteNode(ULNode* node);						//destroys and deallocates a Node
+	static size_t nodeSize(int l);						//returns the number of bytes in a Node on level l
+	void copyFrom(const UnrolledSkipList& toCopy);		//appends copies of the Nodes of another list
+	void trimLevels(void);								//removes empty levels from the top of the list
+
+	static const int MAX_LEVEL = 32;	//hard ceiling on the number of levels
+	Compare compare;					//orders the Objects in the list
+	SLXorShift random;					//picks the height of new Nodes
+	double probability;					//chance of a Node being promoted to the next level
+	int levels;							//number of levels currently in the list
+	int count;							//number of Objects in the list
+	int nodeCount;						//number of Nodes other than the dummy head
+	ULNode* dummyHead;					//dummy head Node with a link for every level, holds no Objects
+};
+
+#endif // !unrolledskiplist_h
+
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list whose Nodes are promoted with a probability of 0.5.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+UnrolledSkipList<Object, Compare, Capacity>::UnrolledSkipList(void) : probability(0.5), levels(1), count(0), nodeCount(0) {
+	dummyHead = createNode(MAX_LEVEL - 1);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Constructor. Instantiates an empty list whose Nodes are promoted to the next level with the
+	parameter probability, 0.5 if it is outside of (0, 1), and ordered with the parameter
+	comparator.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+UnrolledSkipList<Object, Compare, Capacity>::UnrolledSkipList(double promotion, const Compare& comp)
+	: compare(comp), probability((promotion > 0.0 && promotion < 1.0) ? promotion : 0.5), levels(1), count(0), nodeCount(0) {
+	dummyHead = createNode(MAX_LEVEL - 1);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Copy-constructor. Copies every Node of the parameter list with the same Objects and height in
+	O(n).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+UnrolledSkipList<Object, Compare, Capacity>::UnrolledSkipList(const UnrolledSkipList& toCopy)
+	: compare(toCopy.compare), random(toCopy.random), probability(toCopy.probability), levels(1), count(0), nodeCount(0) {
+	dummyHead = createNode(MAX_LEVEL - 1);
+	copyFrom(toCopy);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Destructor. Deletes every Node and the dummy head.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+UnrolledSkipList<Object, Compare, Capacity>::~UnrolledSkipList(void) {
+	makeEmpty();
+	deleteNode(dummyHead);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Overloaded assignment operator. Deletes every Node and copies the Nodes of the parameter list
+	in O(n).
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::operator=(const UnrolledSkipList& toCopy) {
+	if (this == &toCopy) {
+		return;
+	}
+	makeEmpty();
+	compare = toCopy.compare;
+	probability = toCopy.probability;
+	copyFrom(toCopy);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the list. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+int UnrolledSkipList<Object, Compare, Capacity>::size(void) const {
+	return count;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if there are no Objects in the list. Method cannot change any data
+	members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+bool UnrolledSkipList<Object, Compare, Capacity>::isEmpty(void) const {
+	return count == 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Nodes that hold the Objects of the list, not counting the dummy
+	head. size() / nodes() is the average fill of a Node. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+int UnrolledSkipList<Object, Compare, Capacity>::nodes(void) const {
+	return nodeCount;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the Object stored in unused slots. For Nodes searched with vector
+	instructions it is the largest value of the type, so unused slots never count as less than
+	the target. Other Objects are default constructed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+Object UnrolledSkipList<Object, Compare, Capacity>::padding(void) {
+	if constexpr (Vector::enabled) {
+		return numeric_limits<Object>::max();
+	} else {
+		return Object();
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of Objects in the parameter Node that come before the target,
+	which is the slot the target has or would have in the Node. Integers ordered with std::less
+	compare every slot at once with ulCountLess, other Objects use a binary search of the used
+	slots. Method cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+int UnrolledSkipList<Object, Compare, Capacity>::countLess(const ULNode* node, const Object& target) const {
+	if constexpr (Vector::enabled) {
+		return ulCountLess<Object, Capacity>(node->keys, target);
+	} else {
+		int low = 0;
+		int high = node->size;
+		while (low < high) {
+			int middle = (low + high) / 2;
+			if (compare(node->keys[middle], target)) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		return low;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method walks the list from the top level down, moving right while the copy of the smallest
+	Object of the next Node comes before the target, and records in update the last Node on each
+	level whose smallest Object is less than the target (the dummy head if there is none). It
+	then finds the Node the target belongs in:
+		- the Node after update[0] if its smallest Object is equal to the target, slot 0
+		- update[0] if it is not the dummy head, at the slot found by countLess
+		- otherwise the first Node of the list, slot 0, since the target comes before every
+		  Object. node is NULL if the list is empty
+	Method cannot change any data members.
+
+	POSTCONDITIONS:
+		- update[l] holds the last Node on level l whose smallest Object is less than target
+		- node and slot hold the Node and slot the target has or would have
+		- returns true if the target is in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+bool UnrolledSkipList<Object, Compare, Capacity>::locate(const Object& target, ULNode** update, ULNode*& node, int& slot) const {
+	ULNode* current = dummyHead;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		while (current->next[currentLevel].node != NULL && compare(current->next[currentLevel].first, target)) {
+			current = current->next[currentLevel].node;
+		}
+		update[currentLevel] = current;
+	}
+
+	const ULLink& after = current->next[0];
+	if (after.node != NULL && !compare(target, after.first)) {	//the target is the smallest Object of the next Node
+		node = after.node;
+		slot = 0;
+		return true;
+	}
+	if (current != dummyHead) {
+		node = current;
+		slot = countLess(current, target);
+		return slot < current->size && !compare(target, current->keys[slot]);
+	}
+	node = after.node;
+	slot = 0;
+	return false;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns true if the target parameter is in the list. The levels are walked from the
+	top comparing the target with the copies of the smallest Objects held in each link, then
+	the Node the search stopped at is searched with countLess. Method cannot change any data
+	members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+bool UnrolledSkipList<Object, Compare, Capacity>::contains(const Object& target) const {
+	ULNode* current = dummyHead;
+	for (int currentLevel = levels - 1; currentLevel > -1; currentLevel--) {
+		while (current->next[currentLevel].node != NULL && !compare(target, current->next[currentLevel].first)) {
+			current = current->next[currentLevel].node;		//moves while the next Node starts at or before target
+		}
+	}
+	if (current == dummyHead) {
+		return false;
+	}
+	int slot = countLess(current, target);
+	return slot < current->size && !compare(target, current->keys[slot]);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method inserts the parameter Object in to the Node it belongs in, shifting the larger Objects
+	of the Node up one slot. A full Node is split first and the Object goes in to whichever half
+	it belongs in. If the list is empty a new Node is created for the Object. Returns false if
+	the Object is already in the list.
+
+	POSTCONDITIONS:
+		- the Object is in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+bool UnrolledSkipList<Object, Compare, Capacity>::insert(const Object& toInsert) {
+	ULNode* update[MAX_LEVEL];
+	ULNode* node;
+	int slot;
+	if (locate(toInsert, update, node, slot)) {
+		return false;
+	}
+
+	if (node == NULL) {		//the list is empty, the first Node is linked after the dummy head
+		node = createNode(randomLevel());
+		if (node->level == levels) {
+			levels++;
+		}
+		for (int currentLevel = 0; currentLevel <= node->level; currentLevel++) {
+			dummyHead->next[currentLevel].node = node;
+			update[currentLevel] = dummyHead;
+		}
+	} else if (node->size == Capacity) {
+		ULNode* upper = split(node, update);
+		if (slot > node->size) {	//the Object belongs in the upper half
+			slot -= node->size;
+			node = upper;
+		}
+	}
+
+	for (int i = node->size; i > slot; i--) {
+		node->keys[i] = std::move(node->keys[i - 1]);
+	}
+	node->keys[slot] = toInsert;
+	node->size++;
+	count++;
+	if (slot == 0) {		//only the first Node of the list can gain a new smallest Object
+		setFirst(node, update);
+	}
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes the parameter Object from its Node, shifting the larger Objects of the Node
+	down one slot. A Node left empty is unlinked and deleted. A Node that is left at most half
+	full absorbs the Node after it if the Objects of both fit in three quarters of a Node.
+	Returns false if the Object is not in the list.
+
+	POSTCONDITIONS:
+		- the Object is not in the list
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+bool UnrolledSkipList<Object, Compare, Capacity>::remove(const Object& toRemove) {
+	ULNode* update[MAX_LEVEL];
+	ULNode* node;
+	int slot;
+	if (!locate(toRemove, update, node, slot)) {
+		return false;
+	}
+
+	for (int i = slot; i < node->size - 1; i++) {
+		node->keys[i] = std::move(node->keys[i + 1]);
+	}
+	node->size--;
+	node->keys[node->size] = padding();
+	count--;
+
+	if (node->size == 0) {		//the Object was the only one in the Node, so update holds the Nodes before it
+		unlinkNode(node, update);
+		return true;
+	}
+	if (slot == 0) {
+		setFirst(node, update);
+	}
+	ULNode* next = node->next[0].node;
+	if (node->size <= Capacity / 2 && next != NULL && node->size + next->size <= Capacity * 3 / 4) {
+		absorbNext(node, update);
+	}
+	return true;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method copies the smallest Object of the parameter Node in to the link to it on every level
+	it is on. Only called when the smallest Object of the Node was the target of the search that
+	filled update, so update[l] is the Node before it on each of its levels.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::setFirst(ULNode* node, ULNode** update) {
+	for (int currentLevel = 0; currentLevel <= node->level; currentLevel++) {
+		update[currentLevel]->next[currentLevel].first = node->keys[0];
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves the upper half of the Objects of a full Node in to a new Node with a random
+	height and links the new Node right after it. On the levels the full Node is on the new Node
+	is linked after it, and on the levels above after the Node recorded in update, which comes
+	before the full Node. Adds a level if the new Node is taller than the list.
+
+	POSTCONDITIONS:
+		- node holds the lower half of its Objects
+		- returns the new Node holding the upper half
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+typename UnrolledSkipList<Object, Compare, Capacity>::ULNode* UnrolledSkipList<Object, Compare, Capacity>::split(ULNode* node, ULNode** update) {
+	ULNode* upper = createNode(randomLevel());
+	int half = Capacity / 2;
+	for (int i = half; i < Capacity; i++) {
+		upper->keys[i - half] = std::move(node->keys[i]);
+		node->keys[i] = padding();
+	}
+	upper->size = Capacity - half;
+	node->size = half;
+
+	if (upper->level == levels) {	//a Node may only grow the list by one level at a time
+		update[levels] = dummyHead;
+		levels++;
+	}
+	for (int currentLevel = 0; currentLevel <= upper->level; currentLevel++) {
+		ULNode* before = (currentLevel <= node->level) ? node : update[currentLevel];
+		upper->next[currentLevel] = before->next[currentLevel];
+		before->next[currentLevel].node = upper;
+		before->next[currentLevel].first = upper->keys[0];
+	}
+	return upper;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method moves every Object of the Node after the parameter Node in to the end of it and
+	unlinks and deletes the emptied Node. The Node before the emptied Node on each of its levels
+	is node itself or, above the levels of node, the Node recorded in update.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::absorbNext(ULNode* node, ULNode** update) {
+	ULNode* next = node->next[0].node;
+	for (int i = 0; i < next->size; i++) {
+		node->keys[node->size + i] = std::move(next->keys[i]);
+	}
+	node->size += next->size;
+	next->size = 0;
+
+	ULNode* predecessors[MAX_LEVEL];
+	for (int currentLevel = 0; currentLevel <= next->level; currentLevel++) {
+		predecessors[currentLevel] = (currentLevel <= node->level) ? node : update[currentLevel];
+	}
+	unlinkNode(next, predecessors);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method points the Node before the parameter Node on every level it is on past it, deletes
+	it, and drops the levels it was the last Node of.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::unlinkNode(ULNode* node, ULNode* const* predecessors) {
+	for (int currentLevel = 0; currentLevel <= node->level; currentLevel++) {
+		predecessors[currentLevel]->next[currentLevel] = node->next[currentLevel];
+	}
+	deleteNode(node);
+	trimLevels();
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the highest level a new Node will be on, taken from one word of the generator
+	(see slrandom.h), but never more than one level above the current top level or past
+	MAX_LEVEL.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+int UnrolledSkipList<Object, Compare, Capacity>::randomLevel(void) {
+	int nodeLevel = slLevelFromWord(random(), probability);
+	if (nodeLevel > levels) {
+		nodeLevel = levels;
+	}
+	if (nodeLevel > MAX_LEVEL - 1) {
+		nodeLevel = MAX_LEVEL - 1;
+	}
+	return nodeLevel;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns the number of bytes needed for a Node on level l, the fixed part of the Node
+	plus one link per level above the master level.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+size_t UnrolledSkipList<Object, Compare, Capacity>::nodeSize(int l) {
+	return sizeof(ULNode) + l * sizeof(ULLink);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method allocates a Node on level l aligned to a cache line, fills every slot with the padding
+	Object, and sets every link to the end of its level.
+
+	POSTCONDITIONS:
+		- returns an empty Node
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+typename UnrolledSkipList<Object, Compare, Capacity>::ULNode* UnrolledSkipList<Object, Compare, Capacity>::createNode(int l) {
+	ULNode* node = static_cast<ULNode*>(::operator new(nodeSize(l), align_val_t(alignof(ULNode))));
+	for (int i = 0; i < Capacity; i++) {
+		new (&node->keys[i]) Object(padding());
+	}
+	node->size = 0;
+	node->level = l;
+	for (int currentLevel = 0; currentLevel <= l; currentLevel++) {
+		new (&node->next[currentLevel]) ULLink();
+		node->next[currentLevel].node = NULL;
+	}
+	nodeCount++;
+	return node;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method destroys every slot and link of the parameter Node and deallocates it.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::deleteNode(ULNode* node) {
+	for (int i = 0; i < Capacity; i++) {
+		node->keys[i].~Object();
+	}
+	for (int currentLevel = 0; currentLevel <= node->level; currentLevel++) {
+		node->next[currentLevel].~ULLink();
+	}
+	::operator delete(node, align_val_t(alignof(ULNode)));
+	nodeCount--;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method deletes every Node other than the dummy head by walking the master level.
+
+	POSTCONDITIONS:
+		- the list is empty
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::makeEmpty(void) {
+	ULNode* current = dummyHead->next[0].node;
+	while (current != NULL) {
+		ULNode* toDelete = current;
+		current = current->next[0].node;
+		deleteNode(toDelete);
+	}
+	for (int currentLevel = 0; currentLevel < levels; currentLevel++) {
+		dummyHead->next[currentLevel].node = NULL;
+	}
+	levels = 1;
+	count = 0;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method appends a copy of every Node of the parameter list, with the same Objects and height,
+	after the last Node on every level it is on. The list must be empty.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::copyFrom(const UnrolledSkipList& toCopy) {
+	ULNode* tails[MAX_LEVEL];	//last Node on each level
+	for (int currentLevel = 0; currentLevel < MAX_LEVEL; currentLevel++) {
+		tails[currentLevel] = dummyHead;
+	}
+	for (ULNode* source = toCopy.dummyHead->next[0].node; source != NULL; source = source->next[0].node) {
+		ULNode* copy = createNode(source->level);
+		for (int i = 0; i < source->size; i++) {
+			copy->keys[i] = source->keys[i];
+		}
+		copy->size = source->size;
+		for (int currentLevel = 0; currentLevel <= copy->level; currentLevel++) {
+			tails[currentLevel]->next[currentLevel].node = copy;
+			tails[currentLevel]->next[currentLevel].first = copy->keys[0];
+			tails[currentLevel] = copy;
+		}
+	}
+	levels = toCopy.levels;
+	count = toCopy.count;
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method removes empty levels from the top of the list. The master level is never removed.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::trimLevels(void) {
+	while (levels > 1 && dummyHead->next[levels - 1].node == NULL) {
+		levels--;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method prints the list to the console, one Node per row with its level and Objects. Method
+	cannot change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+void UnrolledSkipList<Object, Compare, Capacity>::show(void) const {
+	cout << "contents:" << endl;
+	for (ULNode* row = dummyHead->next[0].node; row != NULL; row = row->next[0].node) {
+		cout << "level " << row->level << ":";
+		for (int i = 0; i < row->size; i++) {
+			cout << "\t" << row->keys[i];
+		}
+		cout << endl;
+	}
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the smallest Object in the list, or end() if the list is empty.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+typename UnrolledSkipList<Object, Compare, Capacity>::const_iterator UnrolledSkipList<Object, Compare, Capacity>::begin(void) const {
+	return const_iterator(dummyHead->next[0].node, 0);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator past the largest Object in the list.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+typename UnrolledSkipList<Object, Compare, Capacity>::const_iterator UnrolledSkipList<Object, Compare, Capacity>::end(void) const {
+	return const_iterator(NULL, 0);
+};
+
+/*-------------------------------------------------------------------------------------------------
+
+	Method returns an iterator to the first Object in the list not less than the target
+	parameter, or end() if there is none. Calls locate as a helper function. Method cannot
+	change any data members.
+
+-------------------------------------------------------------------------------------------------*/
+
+template<class Object, class Compare, int Capacity>
+typename UnrolledSkipList<Object, Compare, Capacity>::const_iterator UnrolledSkipList<Object, Compare, Capacity>::lower_bound(const Object& target) const {
+	ULNode* update[MAX_LEVEL];
+	ULNode* node;
+	int slot;
+	locate(target, update, node, slot);
+	if (node == NULL) {
+		return end();
+	}
+	if (slot == node->size) {		//every Object in the Node is less than target
+		return const_iterator(node->next[0].node, 0);
+	}
+	return const_iterator(node, slot);
+};